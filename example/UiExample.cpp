@@ -5,6 +5,8 @@
 #include <toyui/Types.h>
 
 #include <cfloat>
+#include <chrono>
+#include <cstdio>
 
 using namespace std::placeholders;
 
@@ -86,7 +88,8 @@ namespace toy
 		for(int i = 0; girl_names[i]; i++)
 			list.emplace<Label>(boy_names[i]);
 
-		page.emplace<FilterInput>(list.container());
+		// names are matched anywhere, not only from their first letter
+		page.emplace<FilterInput>(list.container(), nullptr, FILTER_SUBSTRING);
 
 		window.frame().setSize(130.f, 300.f);
 		return window;
@@ -236,11 +239,9 @@ namespace toy
 		Page& tab0 = tabber.addTab("Tab 0").emplace<Page>("Tab 0");
 		createUiTestTable(tab0, false);
 
-		Page& tab1 = tabber.addTab("Tab 1").emplace<Page>("Tab 1");
-		createUiTestInlineControls(tab1);
-
-		Page& tab2 = tabber.addTab("Tab 2").emplace<Page>("Tab 2");
-		createUiTestControls(tab2, false);
+		// the other tabs are only built when first shown
+		tabber.addTab("Tab 1", [](Container& tab) { createUiTestInlineControls(tab.emplace<Page>("Tab 1")); });
+		tabber.addTab("Tab 2", [](Container& tab) { createUiTestControls(tab.emplace<Page>("Tab 2"), false); });
 
 		return page;
 	}
@@ -328,6 +329,53 @@ namespace toy
 		return window;
 	}
 
+	void buildStressTree(Tree& tree, bool heap)
+	{
+		const char* allocator = heap ? "heap" : "arena";
+		UiArena::s_heap = heap;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		tree.clear();
+		auto end = std::chrono::high_resolution_clock::now();
+		printf("Widget stress : cleared in %.2f ms\n", std::chrono::duration<double, std::milli>(end - start).count());
+
+		start = std::chrono::high_resolution_clock::now();
+		for(size_t i = 0; i < 1000; i++)
+		{
+			TreeNode& node = tree.emplace<TreeNode>("", "Node " + toString(i), true);
+			for(size_t j = 0; j < 49; j++)
+				node.emplace<Label>("Leaf " + toString(i) + " : " + toString(j));
+		}
+		end = std::chrono::high_resolution_clock::now();
+
+		UiArena::s_heap = false;
+		printf("Widget stress : built 50000 widgets on the %s in %.2f ms, %zu arena blocks\n", allocator, std::chrono::duration<double, std::milli>(end - start).count(), tree.arena().liveBlocks());
+	}
+
+	Wedge& createUiTestStressTree(Container& parent)
+	{
+		Window& window = parent.emplace<Window>("Widget Stress");
+		Page& page = window.body().emplace<Page>("50k widgets");
+
+		Container& buttons = page.emplace<Container>(Line::cls());
+		Tree& tree = page.emplace<Tree>();
+
+		buildStressTree(tree, false);
+
+		// the same tree built and cleared with each allocator, the times are printed side by side
+		buttons.emplace<Button>("Rebuild in arena", [&tree](Widget&) { buildStressTree(tree, false); });
+		buttons.emplace<Button>("Rebuild on heap", [&tree](Widget&) { buildStressTree(tree, true); });
+		buttons.emplace<Button>("Clear", [&tree](Widget&) {
+			auto start = std::chrono::high_resolution_clock::now();
+			tree.clear();
+			auto end = std::chrono::high_resolution_clock::now();
+			printf("Widget stress : cleared in %.2f ms, %zu arena blocks\n", std::chrono::duration<double, std::milli>(end - start).count(), tree.arena().liveBlocks());
+		});
+
+		window.frame().setSize(300.f, 500.f);
+		return window;
+	}
+
 	Tree& createUiTestTableTree(Container& parent)
 	{
 		Tree& tree = parent.emplace<Tree>();
@@ -510,7 +558,7 @@ namespace toy
 		box1.emplace<InputBool>("closable", true, [&window](bool) { window.toggleClosable(); }, true);
 		box1.emplace<InputBool>("wrap content", false, [&window](bool) { window.toggleWrap(); }, true);
 
-		box1.emplace<SliderFloat>("fill alpha", AutoStat<float>(0.f, 0.f, 1.f, 0.1f), [&window](float alpha){ window.content().inkstyle().m_backgroundColour.val.setA(alpha); });
+		box1.emplace<SliderFloat>("fill alpha", AutoStat<float>(0.f, 0.f, 1.f, 0.1f), [&window](float alpha){ window.content().inkstyle().backgroundColour().setA(alpha); });
 
 		Expandbox& box2 = page.emplace<Expandbox>("Widgets");
 		createUiTestControls(box2, false);
@@ -631,7 +679,7 @@ namespace toy
 		else if(name == "Default")
 			parser.loadDefaultStyle();
 
-		uiWindow.styler().style(CustomElement::cls()).layout().d_align = DimAlign(LEFT, CENTER);
+		uiWindow.styler().style(CustomElement::cls()).layout().setAlign(DimAlign(LEFT, CENTER));
 	}
 
 	void selectUiTheme(Container& sheet, Widget& selected)
@@ -675,6 +723,8 @@ namespace toy
 			createUiTestFileTree(sheet);
 		else if(name == "Progress Dialog")
 			createUiTestProgressDialog(sheet);
+		else if(name == "Widget Stress")
+			createUiTestStressTree(sheet);
 	}
 
 	void createUiTest(Container& rootSheet)
@@ -686,7 +736,7 @@ namespace toy
 		Container& samplebody = demobody.emplace<Container>(Layout::cls());
 		createUiStyleEdit(demobody);
 
-		StringVector samples({ "Application", "Dockspace", "Nodes", "Window", "Text Editor", "Filtered List", "Custom List", "Tabs", "Table", "Tree", "Controls", "File Browser", "File Tree", "Progress Dialog" });
+		StringVector samples({ "Application", "Dockspace", "Nodes", "Window", "Text Editor", "Filtered List", "Custom List", "Tabs", "Table", "Tree", "Controls", "File Browser", "File Tree", "Progress Dialog", "Widget Stress" });
 		StringVector themes({ "Blendish", "Blendish Dark", "TurboBadger", "MyGui" });
 
 		demoheader.emplace<Label>("Pick a demo sample : ");
@@ -20,6 +20,7 @@ namespace toy
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestTabs(Container& parent, bool window = true);
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestTable(Container& parent, bool window = true);
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestTree(Container& parent);
+	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestStressTree(Container& parent);
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestInlineControls(Container& parent);
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestControls(Container& parent, bool window = true);
 	TOY_UIEXAMPLE_EXPORT Wedge& createUiTestProgressDialog(Container& parent);
@@ -3,6 +3,9 @@
 #include <UiExample.h>
 
 #include <toyui/Types.h>
+#include <toyui/Input/InputRecorder.h>
+
+#include <cstring>
 
 #ifdef TOY_PLATFORM_EMSCRIPTEN
 	#include <toyui/Context/EmscriptenContext.h>
@@ -16,6 +19,7 @@
 	}
 #else
 	#include <toyui/Context/Glfw/GlfwContext.h>
+	#include <toyui/Nano/NanoRenderer.h>
 #endif
 
 #ifndef TOYUI_RESOURCE_PATH
@@ -28,6 +32,26 @@ int main(int argc, char *argv[])
 	toy::EmRenderSystem renderSystem(TOYUI_RESOURCE_PATH);
 #else
 	toy::GlfwRenderSystem renderSystem(TOYUI_RESOURCE_PATH);
+
+	// --batch draws with the batched renderer : the fps log gives the draw calls of a frame, and what they would be unbatched
+	// --sdf draws the text with the distance field font, --sdf-check also reports the widths that differ from nanovg text on startup
+	// --onscreen records the floating windows in the main target, to compare with them rasterized offscreen
+	int numArgs = 1;
+	for(int i = 1; i < argc; ++i)
+		if(strcmp(argv[i], "--batch") == 0)
+			renderSystem.setBatchRenderer(true);
+		else if(strcmp(argv[i], "--sdf") == 0)
+			renderSystem.setSdfText(true);
+		else if(strcmp(argv[i], "--sdf-check") == 0)
+		{
+			renderSystem.setSdfText(true);
+			toy::NanoRenderer::sDebugSdfText = true;
+		}
+		else if(strcmp(argv[i], "--onscreen") == 0)
+			toy::Window::sOffscreen = false;
+		else
+			argv[numArgs++] = argv[i];
+	argc = numArgs;
 #endif
 
 	toy::UiWindow uiwindow(renderSystem, "kiUi demo", 1200, 800, false);
@@ -39,8 +63,27 @@ int main(int argc, char *argv[])
 	gWindow = &uiwindow;
 	emscripten_set_main_loop(iterate, 0, 1);
 #else
+	// --record <file> captures the session input, --replay <file> plays it back and reports frame timings
+	if(argc > 2 && strcmp(argv[1], "--replay") == 0)
+	{
+		toy::InputReplayer replayer;
+		if(replayer.load(argv[2]))
+			replayer.replay(uiwindow);
+		if(argc > 3)
+			replayer.saveTimings(argv[3]);
+		return 0;
+	}
+
+	toy::InputRecorder recorder(uiwindow.rootSheet());
+	bool record = argc > 2 && strcmp(argv[1], "--record") == 0;
+	if(record)
+		recorder.start();
+
 	bool pursue = true;
 	while (pursue)
 		pursue = uiwindow.nextFrame();
+
+	if(record)
+		recorder.save(argv[2]);
 #endif
 }
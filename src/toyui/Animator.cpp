@@ -0,0 +1,230 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Animator.h>
+
+#include <toyui/Frame/Frame.h>
+#include <toyui/Frame/Layer.h>
+
+/* std */
+#include <algorithm>
+
+namespace toy
+{
+	Animator::Animator()
+		: m_tick(0)
+		, m_lastId(0)
+	{}
+
+	float Animator::ease(Easing easing, float t)
+	{
+		switch(easing)
+		{
+		case EASE_IN:
+			return t * t;
+		case EASE_OUT:
+			return 1.f - (1.f - t) * (1.f - t);
+		case EASE_IN_OUT:
+			return t < 0.5f ? 2.f * t * t : 1.f - 2.f * (1.f - t) * (1.f - t);
+		case EASE_LINEAR:
+		default:
+			return t;
+		}
+	}
+
+	Animator::TweenId Animator::animate(Frame& frame, TweenProperty property, float to, float duration, Easing easing)
+	{
+		return this->add(frame, TWEEN_BACKGROUND_COLOUR, property, value(frame, TWEEN_BACKGROUND_COLOUR, property), to, duration, easing, ++m_lastId);
+	}
+
+	Animator::TweenId Animator::animatePosition(Frame& frame, float x, float y, float duration, Easing easing)
+	{
+		TweenId id = ++m_lastId;
+		this->add(frame, TWEEN_BACKGROUND_COLOUR, TWEEN_X, frame.dposition(DIM_X), x, duration, easing, id);
+		this->add(frame, TWEEN_BACKGROUND_COLOUR, TWEEN_Y, frame.dposition(DIM_Y), y, duration, easing, id);
+		return id;
+	}
+
+	Animator::TweenId Animator::animateColour(Frame& frame, TweenColour colour, const Colour& to, float duration, Easing easing)
+	{
+		TweenId id = ++m_lastId;
+		const Colour& from = Animator::colour(frame.content().inkstyle(), colour);
+		this->add(frame, colour, TWEEN_COLOUR_R, from.r(), to.r(), duration, easing, id);
+		this->add(frame, colour, TWEEN_COLOUR_G, from.g(), to.g(), duration, easing, id);
+		this->add(frame, colour, TWEEN_COLOUR_B, from.b(), to.b(), duration, easing, id);
+		this->add(frame, colour, TWEEN_COLOUR_A, from.a(), to.a(), duration, easing, id);
+		return id;
+	}
+
+	Animator::TweenId Animator::add(Frame& frame, TweenColour colour, TweenProperty property, float from, float to, float duration, Easing easing, TweenId id)
+	{
+		size_t index = this->find(frame, colour, property);
+		if(index == m_frames.size())
+		{
+			m_ids.push_back(id);
+			m_frames.push_back(&frame);
+			m_colours.push_back(colour);
+			m_properties.push_back(property);
+			m_easings.push_back(easing);
+			m_from.push_back(from);
+			m_to.push_back(to);
+			m_start.push_back(m_tick);
+			m_duration.push_back(duration);
+			return id;
+		}
+
+		m_ids[index] = id;
+		m_easings[index] = easing;
+		m_from[index] = from;
+		m_to[index] = to;
+		m_start[index] = m_tick;
+		m_duration[index] = duration;
+		return id;
+	}
+
+	size_t Animator::find(Frame& frame, TweenColour colour, TweenProperty property)
+	{
+		// the colour only matters for the colour channels, other properties are always added with the background one
+		for(size_t i = 0; i < m_frames.size(); ++i)
+			if(m_frames[i] == &frame && m_colours[i] == colour && m_properties[i] == property)
+				return i;
+		return m_frames.size();
+	}
+
+	void Animator::remove(size_t index)
+	{
+		// the order of the tweens doesn't matter : the last one takes the place of the removed one
+		size_t last = m_frames.size() - 1;
+		m_ids[index] = m_ids[last];
+		m_frames[index] = m_frames[last];
+		m_colours[index] = m_colours[last];
+		m_properties[index] = m_properties[last];
+		m_easings[index] = m_easings[last];
+		m_from[index] = m_from[last];
+		m_to[index] = m_to[last];
+		m_start[index] = m_start[last];
+		m_duration[index] = m_duration[last];
+
+		m_ids.pop_back();
+		m_frames.pop_back();
+		m_colours.pop_back();
+		m_properties.pop_back();
+		m_easings.pop_back();
+		m_from.pop_back();
+		m_to.pop_back();
+		m_start.pop_back();
+		m_duration.pop_back();
+	}
+
+	void Animator::cancel(TweenId id)
+	{
+		for(size_t i = m_ids.size(); i-- > 0;)
+			if(m_ids[i] == id)
+				this->remove(i);
+	}
+
+	void Animator::stop(Frame& frame)
+	{
+		for(size_t i = m_frames.size(); i-- > 0;)
+			if(m_frames[i] == &frame)
+				this->remove(i);
+	}
+
+	void Animator::stop(Frame& frame, TweenProperty property)
+	{
+		for(size_t i = m_frames.size(); i-- > 0;)
+			if(m_frames[i] == &frame && m_properties[i] == property)
+				this->remove(i);
+	}
+
+	bool Animator::animating(Frame& frame)
+	{
+		return std::find(m_frames.begin(), m_frames.end(), &frame) != m_frames.end();
+	}
+
+	void Animator::update(size_t tick)
+	{
+		m_tick = tick;
+
+		size_t i = 0;
+		while(i < m_frames.size())
+		{
+			float t = m_duration[i] > 0.f ? std::min(float(tick - m_start[i]) / m_duration[i], 1.f) : 1.f;
+			float value = m_from[i] + (m_to[i] - m_from[i]) * ease(m_easings[i], t);
+			apply(*m_frames[i], m_colours[i], m_properties[i], value);
+
+			if(t >= 1.f)
+				this->remove(i);
+			else
+				++i;
+		}
+	}
+
+	Colour& Animator::colour(InkStyle& inkstyle, TweenColour colour)
+	{
+		switch(colour)
+		{
+		case TWEEN_BORDER_COLOUR: return inkstyle.borderColour();
+		case TWEEN_TEXT_COLOUR: return inkstyle.textColour();
+		case TWEEN_IMAGE_COLOUR: return inkstyle.imageColour();
+		case TWEEN_BACKGROUND_COLOUR:
+		default: return inkstyle.backgroundColour();
+		}
+	}
+
+	float Animator::value(Frame& frame, TweenColour colour, TweenProperty property)
+	{
+		switch(property)
+		{
+		case TWEEN_X: return frame.dposition(DIM_X);
+		case TWEEN_Y: return frame.dposition(DIM_Y);
+		case TWEEN_SCALE: return frame.scale();
+		case TWEEN_OPACITY: return frame.alpha();
+		case TWEEN_COLOUR_R: return Animator::colour(frame.content().inkstyle(), colour).r();
+		case TWEEN_COLOUR_G: return Animator::colour(frame.content().inkstyle(), colour).g();
+		case TWEEN_COLOUR_B: return Animator::colour(frame.content().inkstyle(), colour).b();
+		case TWEEN_COLOUR_A: return Animator::colour(frame.content().inkstyle(), colour).a();
+		default: return 0.f;
+		}
+	}
+
+	void Animator::apply(Frame& frame, TweenColour channel, TweenProperty property, float value)
+	{
+		Colour* colour = property >= TWEEN_COLOUR_R ? &Animator::colour(frame.content().ownInkstyle(), channel) : nullptr;
+
+		switch(property)
+		{
+		case TWEEN_X:
+			frame.setPositionDim(DIM_X, value);
+			return;
+		case TWEEN_Y:
+			frame.setPositionDim(DIM_Y, value);
+			return;
+		case TWEEN_SCALE:
+			frame.setScale(value);
+			frame.setDirty(Frame::DIRTY_ABSOLUTE);
+			return;
+		case TWEEN_OPACITY:
+			frame.setAlpha(value);
+			break;
+		case TWEEN_COLOUR_R:
+			*colour = Colour(value, colour->g(), colour->b(), colour->a());
+			break;
+		case TWEEN_COLOUR_G:
+			*colour = Colour(colour->r(), value, colour->b(), colour->a());
+			break;
+		case TWEEN_COLOUR_B:
+			*colour = Colour(colour->r(), colour->g(), value, colour->a());
+			break;
+		case TWEEN_COLOUR_A:
+			*colour = Colour(colour->r(), colour->g(), colour->b(), value);
+			break;
+		}
+
+		// the alpha and the colours are recorded in the layer, even an offscreen one needs to be redrawn
+		frame.setDirty(Frame::DIRTY_ABSOLUTE);
+		frame.layer().setRedraw();
+	}
+}
@@ -0,0 +1,105 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_ANIMATOR_H
+#define TOY_ANIMATOR_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyobj/Util/Colour.h>
+#include <toyui/Forward.h>
+
+/* std */
+#include <vector>
+#include <cstdint>
+
+namespace toy
+{
+	enum _I_ TweenProperty : unsigned int
+	{
+		TWEEN_X,
+		TWEEN_Y,
+		TWEEN_SCALE,
+		TWEEN_OPACITY,
+		TWEEN_COLOUR_R,
+		TWEEN_COLOUR_G,
+		TWEEN_COLOUR_B,
+		TWEEN_COLOUR_A
+	};
+
+	enum _I_ TweenColour : unsigned int
+	{
+		TWEEN_BACKGROUND_COLOUR,
+		TWEEN_BORDER_COLOUR,
+		TWEEN_TEXT_COLOUR,
+		TWEEN_IMAGE_COLOUR
+	};
+
+	enum _I_ Easing : unsigned int
+	{
+		EASE_LINEAR,
+		EASE_IN,
+		EASE_OUT,
+		EASE_IN_OUT
+	};
+
+	/* Tweens frame positions, scales and opacities, and colours drawn by a frame, on the clock of the window
+	 * All the running tweens are stored as parallel arrays, one entry per animated channel, updated in one pass each frame
+	 * A tween only marks its frame DIRTY_ABSOLUTE and repaints its layer : animations never trigger a relayout
+	 * Tweening a channel that is already animated starts from the current value, the previous tween is replaced
+	 */
+	class TOY_UI_EXPORT Animator : public NonCopy
+	{
+	public:
+		typedef uint32_t TweenId;
+
+	public:
+		Animator();
+
+		// duration in milliseconds
+		TweenId animate(Frame& frame, TweenProperty property, float to, float duration, Easing easing = EASE_OUT);
+		TweenId animatePosition(Frame& frame, float x, float y, float duration, Easing easing = EASE_OUT);
+		// the colour is tweened on a copy of the inkstyle owned by the frame, the skin it shares with other frames is left untouched
+		TweenId animateColour(Frame& frame, TweenColour colour, const Colour& to, float duration, Easing easing = EASE_OUT);
+
+		void cancel(TweenId id);
+		void stop(Frame& frame);
+		void stop(Frame& frame, TweenProperty property);
+
+		bool animating(Frame& frame);
+
+		// the tweens advance to the tick of the frame, in milliseconds
+		void update(size_t tick);
+
+		bool active() { return !m_frames.empty(); }
+		size_t size() { return m_frames.size(); }
+
+		static float ease(Easing easing, float t);
+
+	protected:
+		TweenId add(Frame& frame, TweenColour colour, TweenProperty property, float from, float to, float duration, Easing easing, TweenId id);
+		void remove(size_t index);
+		size_t find(Frame& frame, TweenColour colour, TweenProperty property);
+
+		static Colour& colour(InkStyle& inkstyle, TweenColour colour);
+		static float value(Frame& frame, TweenColour colour, TweenProperty property);
+		static void apply(Frame& frame, TweenColour colour, TweenProperty property, float value);
+
+	protected:
+		size_t m_tick;
+		TweenId m_lastId;
+
+		std::vector<TweenId> m_ids;
+		std::vector<Frame*> m_frames;
+		std::vector<TweenColour> m_colours;
+		std::vector<TweenProperty> m_properties;
+		std::vector<Easing> m_easings;
+		std::vector<float> m_from;
+		std::vector<float> m_to;
+		std::vector<size_t> m_start;
+		std::vector<float> m_duration;
+	};
+}
+
+#endif // TOY_ANIMATOR_H
@@ -24,6 +24,12 @@ namespace toy
 		this->setLabel(label);
 	}
 
+	Label::Label(Wedge& parent, const string* label, Type& type)
+		: Widget(parent, type)
+	{
+		this->setLabelRef(*label);
+	}
+
 	Text::Text(Wedge& parent, const string& label)
 		: Label(parent, label, cls())
 	{}
@@ -106,14 +112,15 @@ namespace toy
 	void MultiButton::reset(const StringVector& elements)
 	{
 		this->clear();
-		for(const string& value : elements)
+		m_elements = elements;
+		// the labels display the elements this button holds
+		for(const string& value : m_elements)
 		{
 			if(findImage(value).null())
-				this->emplace<Label>(value);
+				this->emplace<Label>(&value);
 			else
 				this->emplace<Icon>(value);
 		}
-		m_elements = elements;
 	}
 
 	Toggle::Toggle(Wedge& parent, const Trigger& triggerOn, const Trigger& triggerOff, bool on, Type& type)
@@ -17,6 +17,8 @@ namespace toy
 	{
 	public:
 		Label(Wedge& parent, const string& label, Type& type = cls());
+		// displays a string owned elsewhere, that outlives the label
+		Label(Wedge& parent, const string* label, Type& type = cls());
 
 		static Type& cls() { static Type ty("Label", Item::cls()); return ty; }
 	};
@@ -55,10 +55,23 @@ namespace toy
 		, m_toggle(*this, std::bind(&Dropdown::dropdown, this, true))
 		, m_list(*this)
 		, m_down(false)
+		, m_content(m_list)
 	{
 		m_list.hide();
 	}
 
+	void Dropdown::setBuilder(const DeferredContent::Builder& builder, size_t releaseDelay)
+	{
+		m_content.setBuilder(builder, releaseDelay);
+	}
+
+	void Dropdown::nextFrame(size_t tick, size_t delta)
+	{
+		WrapButton::nextFrame(tick, delta);
+		if(m_content.update(tick))
+			this->released();
+	}
+
 	DropdownChoice& Dropdown::addChoice()
 	{
 		return m_list.emplace<DropdownChoice>([this](Widget& widget) { this->dropup(); }, StringVector{});
@@ -74,11 +87,13 @@ namespace toy
 	{
 		m_list.hide();
 		m_list.yieldControl();
+		m_content.hidden();
 		m_down = false;
 	}
 
 	void Dropdown::dropdown(bool modal)
 	{
+		m_content.shown();
 		m_list.show();
 		m_list.frame().as<Layer>().moveToTop();
 		m_list.takeControl(CM_MODAL);
@@ -89,6 +104,7 @@ namespace toy
 		: Dropdown(parent, type)
 		, m_onSelected()
 		, m_selected(nullptr)
+		, m_selectedIndex(0)
 	{
 		for(string& choice : choices)
 			this->addChoice({ choice });
@@ -115,6 +131,7 @@ namespace toy
 			m_selected->disableState(ACTIVATED);
 
 		m_selected = &choice;
+		m_selectedIndex = choice.index();
 		m_selected->enableState(ACTIVATED);
 
 		this->updateHead(*m_selected);
@@ -131,6 +148,31 @@ namespace toy
 			m_onSelected(*m_selected);
 	}
 
+	void DropdownInput::deferChoices(const StringVector& choices, size_t releaseDelay)
+	{
+		m_list.clear();
+		m_selected = nullptr;
+		m_choices = choices;
+		m_selectedIndex = 0;
+
+		// the head shows the selection without the list being built
+		if(!m_choices.empty())
+			m_header.reset({ m_choices[0] });
+
+		this->setBuilder([this](Container& list) {
+			size_t selected = m_selectedIndex;
+			for(string& choice : m_choices)
+				this->addChoice({ choice });
+			if(selected < list.containerContents().size())
+				this->select(list.containerContents()[selected]->as<DropdownChoice>());
+		}, releaseDelay);
+	}
+
+	void DropdownInput::released()
+	{
+		m_selected = nullptr;
+	}
+
 	void DropdownInput::updateHead(MultiButton& choice)
 	{
 		m_header.reset(choice.elements());
@@ -9,6 +9,7 @@
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Button/Button.h>
 #include <toyui/Container/List.h>
+#include <toyui/Container/DeferredContent.h>
 
 #include <functional>
 
@@ -59,11 +60,18 @@ namespace toy
 
 		DropdownList& list() { return m_list; }
 		DropdownHead& header() { return m_header; }
+		DeferredContent& content() { return m_content; }
 		bool down() { return m_down; }
 
+		void setBuilder(const DeferredContent::Builder& builder, size_t releaseDelay = 0);
+
+		virtual void nextFrame(size_t tick, size_t delta);
+
 		void dropdown(bool modal = true);
 		void dropup();
 
+		virtual void released() {}
+
 		DropdownChoice& addChoice();
 		virtual Container& emplaceContainer();
 
@@ -74,6 +82,7 @@ namespace toy
 		DropdownToggle m_toggle;
 		DropdownList m_list;
 		bool m_down;
+		DeferredContent m_content;
 	};
 
 	class TOY_UI_EXPORT DropdownInput : public Dropdown
@@ -84,6 +93,10 @@ namespace toy
 		void select(DropdownChoice& selected);
 		void selected(DropdownChoice& selected);
 
+		void deferChoices(const StringVector& choices, size_t releaseDelay = 0);
+
+		virtual void released();
+
 		DropdownChoice& addChoice(const StringVector& elements);
 		virtual Container& emplaceContainer();
 
@@ -94,6 +107,8 @@ namespace toy
 	protected:
 		Trigger m_onSelected;
 		MultiButton* m_selected;
+		size_t m_selectedIndex;
+		StringVector m_choices;
 	};
 }
 
@@ -7,15 +7,132 @@
 
 #include <toyui/Widget/Layout.h>
 
-#include <locale>
+#include <toyui/Frame/Frame.h>
+
+/* std */
+#include <algorithm>
+#include <cctype>
 
 using namespace std::placeholders;
 
 namespace toy
 {
-	FilterInput::FilterInput(Wedge& parent, Wedge& list, std::function<void(string)> callback)
+	FilterIndex::FilterIndex(FilterMode mode)
+		: m_mode(mode)
+		, m_fresh(true)
+	{}
+
+	void FilterIndex::lowercase(string& value)
+	{
+		for(char& c : value)
+			c = char(std::tolower(static_cast<unsigned char>(c)));
+	}
+
+	bool FilterIndex::stale(Wedge& list)
+	{
+		if(m_widgets.size() != list.count())
+			return true;
+
+		for(size_t i = 0; i < m_widgets.size(); ++i)
+			if(m_widgets[i] != &list.at(i))
+				return true;
+
+		return false;
+	}
+
+	void FilterIndex::index(Wedge& list)
+	{
+		m_widgets.assign(list.contents().begin(), list.contents().end());
+		m_labels.resize(m_widgets.size());
+		m_scores.assign(m_widgets.size(), 0);
+		m_fits.resize(m_widgets.size());
+		m_matches.clear();
+
+		for(size_t i = 0; i < m_widgets.size(); ++i)
+		{
+			m_labels[i] = m_widgets[i]->contentlabel();
+			lowercase(m_labels[i]);
+			m_fits[i] = !m_widgets[i]->frame().hidden();
+		}
+
+		m_filter.clear();
+		m_fresh = true;
+	}
+
+	int FilterIndex::score(const string& filter, const string& label)
+	{
+		if(filter.size() > label.size())
+			return -1;
+
+		if(m_mode == FILTER_PREFIX)
+			return label.compare(0, filter.size(), filter) == 0 ? 0 : -1;
+
+		if(m_mode == FILTER_SUBSTRING)
+		{
+			size_t pos = label.find(filter);
+			return pos == string::npos ? -1 : int(pos);
+		}
+
+		// fuzzy : the filter must be a subsequence of the label, gaps between matched characters are penalized
+		int score = 0;
+		size_t pos = 0;
+		for(size_t i = 0; i < filter.size(); ++i, ++pos)
+		{
+			size_t found = label.find(filter[i], pos);
+			if(found == string::npos)
+				return -1;
+			score += int(found - pos);
+			pos = found;
+		}
+		return score;
+	}
+
+	void FilterIndex::update(const string& input)
+	{
+		string filter = input;
+		lowercase(filter);
+
+		// when the filter only grows, the new matches are a subset of the current ones
+		bool narrow = !m_fresh && filter.size() >= m_filter.size() && filter.compare(0, m_filter.size(), m_filter) == 0;
+		if(narrow && filter.size() == m_filter.size())
+			return;
+
+		std::vector<size_t> candidates;
+		if(narrow)
+		{
+			candidates.swap(m_matches);
+		}
+		else
+		{
+			candidates.resize(m_widgets.size());
+			for(size_t i = 0; i < candidates.size(); ++i)
+				candidates[i] = i;
+		}
+
+		for(size_t i : candidates)
+			m_fits[i] = false;
+
+		m_matches.clear();
+		for(size_t i : candidates)
+		{
+			m_scores[i] = this->score(filter, m_labels[i]);
+			if(m_scores[i] >= 0)
+			{
+				m_fits[i] = true;
+				m_matches.push_back(i);
+			}
+		}
+
+		std::stable_sort(m_matches.begin(), m_matches.end(), [this](size_t a, size_t b) { return m_scores[a] < m_scores[b]; });
+
+		m_filter = filter;
+		m_fresh = false;
+	}
+
+	FilterInput::FilterInput(Wedge& parent, Wedge& list, std::function<void(string)> callback, FilterMode mode)
 		: Input<string>(parent, "", callback)
 		, m_list(list)
+		, m_index(mode)
 	{}
 
 	void FilterInput::filterOn()
@@ -28,27 +145,53 @@ namespace toy
 		this->updateFilter("");
 	}
 
+	void FilterInput::reindex()
+	{
+		m_index.index(m_list);
+	}
+
 	void FilterInput::updateFilter(const string& filter)
 	{
-		for(auto& pt : m_list.contents())
+		if(m_index.stale(m_list))
+			m_index.index(m_list);
+
+		m_index.update(filter);
+
+		// visibility is applied locally on each frame, the list is marked dirty once for all of them
+		bool changed = false;
+		for(size_t i = 0; i < m_index.size(); ++i)
 		{
-			bool fit = fitsFilter(filter, pt->contentlabel());
-			if(fit && pt->frame().hidden())
-				pt->show();
-			else if(!fit && !pt->frame().hidden())
-				pt->hide();
+			Frame& frame = m_index.widget(i).frame();
+			if(m_index.fits(i) == frame.hidden())
+			{
+				frame.setHidden(!m_index.fits(i));
+				changed = true;
+			}
 		}
+
+		if(changed)
+			m_list.frame().markDirty(Frame::DIRTY_LAYOUT);
 	}
 
 	bool FilterInput::fitsFilter(const string& filter, const string& value)
 	{
+		if(filter.size() > value.size())
+			return false;
+
 		for(size_t i = 0; i < filter.size(); ++i)
-			if(std::tolower(filter[i], std::locale()) != std::tolower(value[i], std::locale()))
+			if(std::tolower(static_cast<unsigned char>(filter[i])) != std::tolower(static_cast<unsigned char>(value[i])))
 				return false;
 
 		return true;
 	}
 
+	Widget* FilterInput::bestMatch()
+	{
+		if(m_index.matches().empty())
+			return nullptr;
+		return &m_index.widget(m_index.matches().front());
+	}
+
 	void FilterInput::notifyModify()
 	{
 		Input<string>::notifyModify();
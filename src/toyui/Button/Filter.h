@@ -11,25 +11,77 @@
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Edit/TypeIn.h>
 
+/* std */
+#include <vector>
+
 namespace toy
 {
+	enum FilterMode
+	{
+		FILTER_PREFIX,
+		FILTER_SUBSTRING,
+		FILTER_FUZZY
+	};
+
+	class TOY_UI_EXPORT FilterIndex
+	{
+	public:
+		FilterIndex(FilterMode mode = FILTER_PREFIX);
+
+		FilterMode mode() { return m_mode; }
+		void setMode(FilterMode mode) { m_mode = mode; m_filter.clear(); m_fresh = true; }
+
+		size_t size() { return m_widgets.size(); }
+		Widget& widget(size_t index) { return *m_widgets[index]; }
+		bool fits(size_t index) { return m_fits[index]; }
+
+		// Matching items ordered by rank, best match first
+		const std::vector<size_t>& matches() { return m_matches; }
+
+		bool stale(Wedge& list);
+		void index(Wedge& list);
+
+		void update(const string& filter);
+
+		int score(const string& filter, const string& label);
+
+		static void lowercase(string& value);
+
+	protected:
+		FilterMode m_mode;
+		std::vector<Widget*> m_widgets;
+		std::vector<string> m_labels;
+		std::vector<int> m_scores;
+		std::vector<bool> m_fits;
+		std::vector<size_t> m_matches;
+		string m_filter;
+		bool m_fresh;
+	};
+
 	class TOY_UI_EXPORT FilterInput : public Input<string>
 	{
 	public:
-		FilterInput(Wedge& parent, Wedge& list, std::function<void(string)> callback = nullptr);
+		FilterInput(Wedge& parent, Wedge& list, std::function<void(string)> callback = nullptr, FilterMode mode = FILTER_PREFIX);
+
+		FilterIndex& filterIndex() { return m_index; }
 
 		void filterOn();
 		void filterOff();
 
 		void notifyModify();
 
+		void reindex();
+
 		void updateFilter(const string& filter);
-		bool fitsFilter(const string& filter, const string& value);
+		static bool fitsFilter(const string& filter, const string& value);
+
+		Widget* bestMatch();
 
 		static Type& cls() { static Type ty("FilterInput", Input<string>::cls()); return ty; }
 
 	protected:
 		Wedge& m_list;
+		FilterIndex m_index;
 	};
 }
 
@@ -11,6 +11,8 @@
 
 #include <toyui/Button/Slider.h>
 
+#include <toyui/UiWindow.h>
+
 #include <toyobj/Iterable/Reverse.h>
 
 namespace toy
@@ -40,6 +42,8 @@ namespace toy
 		: Button(parent, "", trigger, cls())
 	{}
 
+	float Scrollbar::s_scrollDuration = 120.f;
+
 	Scrollbar::Scrollbar(Wedge& parent, Wedge& frameSheet, Wedge& contentSheet, Dimension dim)
 		: Container(parent, cls())
 		, m_dim(dim)
@@ -74,19 +78,29 @@ namespace toy
 	void Scrollbar::scrollup()
 	{
 		float pos = m_frameSheet.stripe().prevOffset(m_dim, -10.f);
-		this->scrollTo(std::max(0.f, d_cursor + pos));
+		this->scrollTo(std::max(0.f, d_cursor + pos), true);
 	}
 
 	void Scrollbar::scrolldown()
 	{
 		float pos = m_frameSheet.stripe().nextOffset(m_dim, 10.f);
-		this->scrollTo(std::min(this->overflow(), d_cursor + pos));
+		this->scrollTo(std::min(this->overflow(), d_cursor + pos), true);
 	}
 
-	void Scrollbar::scrollTo(float offset)
+	void Scrollbar::scrollTo(float offset, bool animate)
 	{
 		d_cursor = offset;
-		m_contentSheet.frame().setPositionDim(m_dim, -offset);
+
+		Animator& animator = this->uiWindow().animator();
+		TweenProperty property = m_dim == DIM_X ? TWEEN_X : TWEEN_Y;
+		if(animate)
+			animator.animate(m_contentSheet.frame(), property, -offset, s_scrollDuration);
+		else
+		{
+			animator.stop(m_contentSheet.frame(), property);
+			m_contentSheet.frame().setPositionDim(m_dim, -offset);
+		}
+
 		m_contentSheet.frame().layer().setForceRedraw();
 	}
 
@@ -107,6 +121,10 @@ namespace toy
 	{
 		Wedge::nextFrame(tick, delta);
 
+		// each step of a scroll animation redraws the content like a jump would
+		if(this->uiWindow().animator().animating(m_contentSheet.frame()))
+			m_contentSheet.frame().layer().setForceRedraw();
+
 		float visibleSize = this->visibleSize();
 		float contentSize = this->contentSize();
 		float overflow = this->overflow();
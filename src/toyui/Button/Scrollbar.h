@@ -92,12 +92,15 @@ namespace toy
 		void scrollup();
 		void scrolldown();
 		void scroll(float amount);
-		void scrollTo(float offset);
+		// an animated scroll slides the content to the offset, the cursor moves right away
+		void scrollTo(float offset, bool animate = false);
 
 		void nextFrame(size_t tick, size_t delta);
 
 		static Type& cls() { static Type ty("Scrollbar", Line::cls()); return ty; }
 
+		static float s_scrollDuration;
+
 	protected:
 		Dimension m_dim;
 		float d_cursor;
@@ -0,0 +1,82 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Container/DeferredContent.h>
+
+#include <toyui/Widget/Sheet.h>
+
+namespace toy
+{
+	DeferredContent::DeferredContent(Container& container)
+		: m_container(container)
+		, m_builder()
+		, m_releaseDelay(0)
+		, m_built(false)
+		, m_hidden(true)
+		, m_stamped(false)
+		, m_hiddenSince(0)
+	{}
+
+	void DeferredContent::setBuilder(const Builder& builder, size_t releaseDelay)
+	{
+		if(m_built)
+			this->release();
+
+		m_builder = builder;
+		m_releaseDelay = releaseDelay;
+	}
+
+	void DeferredContent::shown()
+	{
+		m_hidden = false;
+		m_stamped = false;
+		this->build();
+	}
+
+	void DeferredContent::hidden()
+	{
+		m_hidden = true;
+		m_stamped = false;
+	}
+
+	bool DeferredContent::update(size_t tick)
+	{
+		if(!m_built || !m_hidden || m_releaseDelay == 0)
+			return false;
+
+		// the hiding time is only known on the next frame
+		if(!m_stamped)
+		{
+			m_hiddenSince = tick;
+			m_stamped = true;
+			return false;
+		}
+
+		if(tick - m_hiddenSince < m_releaseDelay)
+			return false;
+
+		this->release();
+		return true;
+	}
+
+	void DeferredContent::build()
+	{
+		if(m_built || !m_builder)
+			return;
+
+		m_built = true;
+		m_builder(m_container);
+	}
+
+	void DeferredContent::release()
+	{
+		if(!m_built || !m_builder)
+			return;
+
+		m_container.clear();
+		m_built = false;
+		m_stamped = false;
+	}
+}
@@ -0,0 +1,51 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_DEFERREDCONTENT_H
+#define TOY_DEFERREDCONTENT_H
+
+/* toy */
+#include <toyui/Forward.h>
+
+/* std */
+#include <functional>
+
+namespace toy
+{
+	/* Content of a container built by a callback the first time it is shown, instead of being built upfront and hidden
+	 * With a release delay, the content is cleared again once it has stayed hidden for that many ticks, and rebuilt when shown
+	 */
+	class TOY_UI_EXPORT DeferredContent
+	{
+	public:
+		typedef std::function<void(Container&)> Builder;
+
+	public:
+		DeferredContent(Container& container);
+
+		bool deferred() const { return m_builder != nullptr; }
+		bool built() const { return m_built; }
+
+		void setBuilder(const Builder& builder, size_t releaseDelay = 0);
+
+		void shown();
+		void hidden();
+
+		bool update(size_t tick);
+
+		void build();
+		void release();
+
+	protected:
+		Container& m_container;
+		Builder m_builder;
+		size_t m_releaseDelay;
+		bool m_built;
+		bool m_hidden;
+		bool m_stamped;
+		size_t m_hiddenSince;
+	};
+}
+
+#endif // TOY_DEFERREDCONTENT_H
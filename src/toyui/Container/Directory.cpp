@@ -8,11 +8,21 @@
 #include <toyui/Button/Button.h>
 
 #include <dirent.h>
+#include <sys/stat.h>
+
+#if defined TOY_PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/* std */
+#include <iterator>
+#include <algorithm>
 
 namespace toy
 {
 	Dir::Dir(Wedge& parent, Directory& directory, const string& name)
-		: MultiButton(parent, Trigger(), { "folder_20" , m_name }, cls())
+		: MultiButton(parent, Trigger(), { "folder_20" , name }, cls())
 		, m_directory(directory)
 		, m_name(name)
 	{}
@@ -29,7 +39,7 @@ namespace toy
 	}
 
 	File::File(Wedge& parent, Directory& directory, const string& name)
-		: MultiButton(parent, Trigger(), { "file_20", m_name }, cls())
+		: MultiButton(parent, Trigger(), { "file_20", name }, cls())
 		, m_directory(directory)
 		, m_name(name)
 	{}
@@ -37,35 +47,318 @@ namespace toy
 	void File::click()
 	{}
 
-	Directory::Directory(Wedge& parent, const string& path)
+	size_t DirectoryLister::s_batchSize = 256;
+
+	DirectoryLister::DirectoryLister()
+		: m_modified(0)
+		, m_cancel(false)
+		, m_done(true)
+	{}
+
+	DirectoryLister::~DirectoryLister()
+	{
+		this->stop();
+	}
+
+	void DirectoryLister::start(const string& path)
+	{
+		this->stop();
+
+		m_dirs.clear();
+		m_files.clear();
+
+		struct stat info;
+		m_modified = stat(path.c_str(), &info) == 0 ? info.st_mtime : 0;
+
+		m_cancel = false;
+		m_done = false;
+		m_thread = std::thread(&DirectoryLister::list, this, path);
+	}
+
+	void DirectoryLister::stop()
+	{
+		m_cancel = true;
+		if(m_thread.joinable())
+			m_thread.join();
+		m_done = true;
+	}
+
+	bool DirectoryLister::pop(DirListing& dirs, DirListing& files)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_dirs.empty() && m_files.empty())
+			return false;
+
+		dirs.insert(dirs.end(), std::make_move_iterator(m_dirs.begin()), std::make_move_iterator(m_dirs.end()));
+		files.insert(files.end(), std::make_move_iterator(m_files.begin()), std::make_move_iterator(m_files.end()));
+		m_dirs.clear();
+		m_files.clear();
+		return true;
+	}
+
+	void DirectoryLister::list(string path)
+	{
+		DirListing dirs;
+		DirListing files;
+
+		auto flush = [&]() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_dirs.insert(m_dirs.end(), std::make_move_iterator(dirs.begin()), std::make_move_iterator(dirs.end()));
+			m_files.insert(m_files.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+			dirs.clear();
+			files.clear();
+		};
+
+		DIR* dir = opendir(path.c_str());
+		dirent* ent;
+
+		while(dir && !m_cancel && (ent = readdir(dir)) != NULL)
+		{
+			if(ent->d_type & DT_DIR && string(ent->d_name) != ".")
+				dirs.push_back({ ent->d_name, true });
+			else if(ent->d_type & DT_REG)
+				files.push_back({ ent->d_name, false });
+
+			if(dirs.size() + files.size() >= s_batchSize)
+				flush();
+		}
+
+		flush();
+
+		if(dir)
+			closedir(dir);
+
+		m_done = true;
+	}
+
+	DirectoryCache::Listing* DirectoryCache::find(const string& path)
+	{
+		auto it = m_listings.find(path);
+		if(it == m_listings.end())
+			return nullptr;
+
+		struct stat info;
+		if(stat(path.c_str(), &info) != 0 || info.st_mtime != it->second.d_modified)
+		{
+			m_listings.erase(it);
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	void DirectoryCache::store(const string& path, const DirListing& dirs, const DirListing& files, time_t modified)
+	{
+		m_listings[path] = { dirs, files, modified };
+	}
+
+	void DirectoryCache::invalidate(const string& path)
+	{
+		m_listings.erase(path);
+	}
+
+	DirectoryWatcher::DirectoryWatcher()
+		: m_fd(-1)
+		, m_watch(-1)
+	{
+#if defined TOY_PLATFORM_LINUX
+		m_fd = inotify_init1(IN_NONBLOCK);
+#endif
+	}
+
+	DirectoryWatcher::~DirectoryWatcher()
+	{
+		this->unwatch();
+#if defined TOY_PLATFORM_LINUX
+		if(m_fd >= 0)
+			close(m_fd);
+#endif
+	}
+
+	void DirectoryWatcher::watch(const string& path)
+	{
+		this->unwatch();
+#if defined TOY_PLATFORM_LINUX
+		if(m_fd >= 0)
+			m_watch = inotify_add_watch(m_fd, path.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+#else
+		UNUSED(path);
+#endif
+	}
+
+	void DirectoryWatcher::unwatch()
+	{
+#if defined TOY_PLATFORM_LINUX
+		if(m_watch >= 0)
+			inotify_rm_watch(m_fd, m_watch);
+
+		// drain the events of the previous watch
+		this->changed();
+#endif
+		m_watch = -1;
+	}
+
+	bool DirectoryWatcher::changed()
+	{
+		bool changed = false;
+#if defined TOY_PLATFORM_LINUX
+		char buffer[4096];
+		while(m_fd >= 0 && read(m_fd, buffer, sizeof(buffer)) > 0)
+			changed = true;
+#endif
+		return changed;
+	}
+
+	size_t Directory::s_maxInsertsPerFrame = 200;
+	bool Directory::s_cacheListings = true;
+
+	Directory::Directory(Wedge& parent, const string& path, size_t windowSize)
 		: Container(parent, cls())
 		, m_path(path)
+		, m_listing(false)
+		, m_numDirWidgets(0)
+		, m_numFileWidgets(0)
+		, m_windowFirst(0)
+		, m_windowSize(windowSize)
+		, m_windowDirty(false)
 	{
 		this->update();
 	}
 
+	Directory::~Directory()
+	{
+		m_lister.stop();
+	}
+
+	void Directory::nextFrame(size_t tick, size_t delta)
+	{
+		if(m_watcher.changed())
+			this->refresh();
+
+		this->receive();
+
+		if(m_windowSize == 0)
+			this->insertWidgets();
+		else if(m_windowDirty)
+			this->rebuildWindow();
+
+		Container::nextFrame(tick, delta);
+	}
+
 	void Directory::update()
 	{
-		DIR* dir = opendir(m_path.c_str());
-		dirent* ent;
+		m_lister.stop();
+		m_listing = false;
 
-		while((ent = readdir(dir)) != NULL)
-			if(ent->d_type & DT_DIR && string(ent->d_name) != ".")
-				this->emplace<Dir>(*this, ent->d_name);
+		this->clear();
+		m_dirs.clear();
+		m_files.clear();
+		m_numDirWidgets = 0;
+		m_numFileWidgets = 0;
+		m_windowDirty = true;
 
-		rewinddir(dir);
+		m_watcher.watch(m_path);
 
-		while((ent = readdir(dir)) != NULL)
-			if(ent->d_type & DT_REG)
-				this->emplace<File>(*this, ent->d_name);
+		DirectoryCache::Listing* listing = s_cacheListings ? DirectoryCache::me().find(m_path) : nullptr;
+		if(listing)
+		{
+			m_dirs = listing->d_dirs;
+			m_files = listing->d_files;
+			return;
+		}
 
-		closedir(dir);
+		m_listing = true;
+		m_lister.start(m_path);
+	}
+
+	void Directory::refresh()
+	{
+		DirectoryCache::me().invalidate(m_path);
+		this->update();
+	}
+
+	void Directory::receive()
+	{
+		if(!m_listing)
+			return;
+
+		// read the done flag first : everything listed before it was raised is popped below
+		bool finished = m_lister.done();
+
+		size_t numDirs = m_dirs.size();
+		size_t numEntries = this->numEntries();
+
+		if(m_lister.pop(m_dirs, m_files) && m_windowSize > 0)
+			if(m_dirs.size() > numDirs || numEntries < m_windowFirst + m_windowSize)
+				m_windowDirty = true;
+
+		if(finished)
+		{
+			m_listing = false;
+			if(s_cacheListings)
+				DirectoryCache::me().store(m_path, m_dirs, m_files, m_lister.modified());
+		}
+	}
+
+	void Directory::insertWidgets()
+	{
+		size_t budget = s_maxInsertsPerFrame;
+
+		for(; budget > 0 && m_numDirWidgets < m_dirs.size(); --budget)
+		{
+			Widget& widget = this->emplaceEntry(m_dirs[m_numDirWidgets]);
+			if(widget.index() != m_numDirWidgets)
+				widget.parent()->move(widget.index(), m_numDirWidgets);
+			++m_numDirWidgets;
+		}
+
+		for(; budget > 0 && m_numFileWidgets < m_files.size(); --budget)
+		{
+			this->emplaceEntry(m_files[m_numFileWidgets]);
+			++m_numFileWidgets;
+		}
+	}
+
+	void Directory::rebuildWindow()
+	{
+		this->clear();
+
+		size_t end = std::min(m_windowFirst + m_windowSize, this->numEntries());
+		for(size_t i = m_windowFirst; i < end; ++i)
+			this->emplaceEntry(this->entry(i));
+
+		m_windowDirty = false;
+	}
+
+	void Directory::setWindow(size_t first, size_t count)
+	{
+		if(first == m_windowFirst && count == m_windowSize)
+			return;
+
+		m_windowFirst = first;
+		m_windowSize = count;
+		m_windowDirty = true;
+
+		if(m_windowSize == 0)
+		{
+			this->clear();
+			m_numDirWidgets = 0;
+			m_numFileWidgets = 0;
+		}
+	}
+
+	Widget& Directory::emplaceEntry(const DirEntry& entry)
+	{
+		if(entry.d_directory)
+			return this->emplace<Dir>(*this, entry.d_name);
+		else
+			return this->emplace<File>(*this, entry.d_name);
 	}
 
 	void Directory::setLocation(const string& path)
 	{
 		m_path = path;
-		this->clear();
+		m_windowFirst = 0;
 		this->update();
 	}
 
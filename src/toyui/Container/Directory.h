@@ -11,6 +11,15 @@
 #include <toyui/Button/Button.h>
 #include <toyui/Container/Tree.h>
 
+#include <toyobj/Util/NonCopy.h>
+
+/* std */
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <map>
+#include <ctime>
+
 struct dirent;
 
 namespace toy
@@ -43,21 +52,133 @@ namespace toy
 		string m_name;
 	};
 
+	struct TOY_UI_EXPORT DirEntry
+	{
+		string d_name;
+		bool d_directory;
+	};
+
+	typedef std::vector<DirEntry> DirListing;
+
+	class TOY_UI_EXPORT DirectoryLister : public NonCopy
+	{
+	public:
+		DirectoryLister();
+		~DirectoryLister();
+
+		bool done() { return m_done; }
+		time_t modified() { return m_modified; }
+
+		void start(const string& path);
+		void stop();
+
+		// Moves the entries read by the listing thread so far into the two lists
+		bool pop(DirListing& dirs, DirListing& files);
+
+		static size_t s_batchSize;
+
+	protected:
+		void list(string path);
+
+	protected:
+		std::thread m_thread;
+		std::mutex m_mutex;
+		DirListing m_dirs;
+		DirListing m_files;
+		time_t m_modified;
+		std::atomic<bool> m_cancel;
+		std::atomic<bool> m_done;
+	};
+
+	class TOY_UI_EXPORT DirectoryCache : public NonCopy
+	{
+	public:
+		struct Listing
+		{
+			DirListing d_dirs;
+			DirListing d_files;
+			time_t d_modified;
+		};
+
+		Listing* find(const string& path);
+
+		void store(const string& path, const DirListing& dirs, const DirListing& files, time_t modified);
+		void invalidate(const string& path);
+
+		static DirectoryCache& me() { static DirectoryCache instance; return instance; }
+
+	protected:
+		std::map<string, Listing> m_listings;
+	};
+
+	class TOY_UI_EXPORT DirectoryWatcher : public NonCopy
+	{
+	public:
+		DirectoryWatcher();
+		~DirectoryWatcher();
+
+		void watch(const string& path);
+		void unwatch();
+
+		bool changed();
+
+	protected:
+		int m_fd;
+		int m_watch;
+	};
+
 	class _I_ TOY_UI_EXPORT Directory : public Container
 	{
 	public:
-		Directory(Wedge& parent, const string& path);
+		Directory(Wedge& parent, const string& path, size_t windowSize = 0);
+		~Directory();
+
+		const string& path() { return m_path; }
+		const DirListing& dirs() { return m_dirs; }
+		const DirListing& files() { return m_files; }
+
+		size_t numEntries() { return m_dirs.size() + m_files.size(); }
+		const DirEntry& entry(size_t index) { return index < m_dirs.size() ? m_dirs[index] : m_files[index - m_dirs.size()]; }
+
+		bool loading() { return m_listing; }
+
+		void nextFrame(size_t tick, size_t delta);
 
 		void update();
+		void refresh();
 
 		void setLocation(const string& path);
 		void moveIn(const string& name);
 		void moveOut();
 
+		void setWindow(size_t first, size_t count);
+
 		static Type& cls() { static Type ty("Directory", Container::cls()); return ty; }
 
+		static size_t s_maxInsertsPerFrame;
+		static bool s_cacheListings;
+
+	protected:
+		void receive();
+		void insertWidgets();
+		void rebuildWindow();
+
+		Widget& emplaceEntry(const DirEntry& entry);
+
 	protected:
 		string m_path;
+		DirectoryLister m_lister;
+		DirectoryWatcher m_watcher;
+		bool m_listing;
+
+		DirListing m_dirs;
+		DirListing m_files;
+		size_t m_numDirWidgets;
+		size_t m_numFileWidgets;
+
+		size_t m_windowFirst;
+		size_t m_windowSize;
+		bool m_windowDirty;
 	};
 
 	class _I_ TOY_UI_EXPORT FileBrowser : public Wedge
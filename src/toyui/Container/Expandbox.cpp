@@ -32,6 +32,7 @@ namespace toy
 		, m_title(m_header, title)
 		, m_container(*this)
 		, m_collapsed(collapsed)
+		, m_content(m_container)
 	{
 		m_container.hide();
 	}
@@ -39,6 +40,23 @@ namespace toy
 	Expandbox::~Expandbox()
 	{}
 
+	void Expandbox::setBuilder(const DeferredContent::Builder& builder, size_t releaseDelay)
+	{
+		m_content.setBuilder(builder, releaseDelay);
+
+		if(!m_collapsed)
+		{
+			m_content.shown();
+			m_container.show();
+		}
+	}
+
+	void Expandbox::nextFrame(size_t tick, size_t delta)
+	{
+		Container::nextFrame(tick, delta);
+		m_content.update(tick);
+	}
+
 	Container& Expandbox::emplaceContainer()
 	{
 		if(!m_collapsed && m_container.frame().hidden())
@@ -49,6 +67,7 @@ namespace toy
 
 	void Expandbox::expand()
 	{
+		m_content.shown();
 		m_container.show();
 		m_collapsed = false;
 	}
@@ -56,6 +75,7 @@ namespace toy
 	void Expandbox::collapse()
 	{
 		m_container.hide();
+		m_content.hidden();
 		m_collapsed = true;
 	}
 }
@@ -9,6 +9,7 @@
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Widget/Layout.h>
 #include <toyui/Button/Button.h>
+#include <toyui/Container/DeferredContent.h>
 
 namespace toy
 {
@@ -43,6 +44,11 @@ namespace toy
 		~Expandbox();
 
 		Wedge& header() { return m_header; }
+		DeferredContent& content() { return m_content; }
+
+		void setBuilder(const DeferredContent::Builder& builder, size_t releaseDelay = 0);
+
+		virtual void nextFrame(size_t tick, size_t delta);
 
 		virtual Container& emplaceContainer();
 
@@ -57,6 +63,7 @@ namespace toy
 		Label m_title;
 		ExpandboxBody m_container;
 		bool m_collapsed;
+		DeferredContent m_content;
 	};
 }
 
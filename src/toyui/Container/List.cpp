@@ -38,9 +38,10 @@ namespace toy
 
 	LabelSequence::LabelSequence(Wedge& parent, StringVector labels)
 		: Container(parent, cls())
+		, m_labels(std::move(labels))
 	{
-		for(string& label : labels)
-			this->emplace<Label>(label);
+		for(const string& label : m_labels)
+			this->emplace<Label>(&label);
 	}
 	
 	ButtonSequence::ButtonSequence(Wedge& parent, StringVector labels)
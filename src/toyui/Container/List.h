@@ -41,6 +41,9 @@ namespace toy
 		LabelSequence(Wedge& parent, StringVector labels = StringVector());
 
 		static Type& cls() { static Type ty("LabelSequence", Line::cls()); return ty; }
+
+	protected:
+		StringVector m_labels;
 	};
 
 	class TOY_UI_EXPORT ButtonSequence : public Container
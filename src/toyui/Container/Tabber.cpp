@@ -22,6 +22,7 @@ namespace toy
 		, m_tabber(tabber)
 		, m_header(header)
 		, m_active(active)
+		, m_content(*this)
 	{
 		if(!m_active)
 			this->hide();
@@ -29,6 +30,12 @@ namespace toy
 			m_header.activate();
 	}
 
+	void Tab::nextFrame(size_t tick, size_t delta)
+	{
+		ScrollSheet::nextFrame(tick, delta);
+		m_content.update(tick);
+	}
+
 	void Tab::handleRemove(Widget& widget)
 	{
 		m_tabber.removeTab(*this);
@@ -70,6 +77,17 @@ namespace toy
 		return tab;
 	}
 
+	Tab& Tabber::addTab(const string& name, const DeferredContent::Builder& builder, size_t releaseDelay)
+	{
+		Tab& tab = this->addTab(name);
+		tab.content().setBuilder(builder, releaseDelay);
+
+		if(&tab == m_currentTab)
+			tab.content().shown();
+
+		return tab;
+	}
+
 	void Tabber::removeTab(Tab& tab)
 	{
 		if(&tab == m_currentTab)
@@ -100,7 +118,9 @@ namespace toy
 		{
 			m_currentTab->hide();
 			m_currentTab->header().deactivate();
+			m_currentTab->content().hidden();
 		}
+		tab.content().shown();
 		tab.show();
 		tab.header().activate();
 		m_currentTab = &tab;
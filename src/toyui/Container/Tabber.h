@@ -9,6 +9,7 @@
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Widget/ScrollSheet.h>
 #include <toyui/Button/Button.h>
+#include <toyui/Container/DeferredContent.h>
 
 namespace toy
 {
@@ -25,9 +26,12 @@ namespace toy
 	public:
 		Tab(Wedge& parent, Tabber& tabber, Button& header, bool active);
 
+		virtual void nextFrame(size_t tick, size_t delta);
+
 		void handleRemove(Widget& widget);
 
 		Button& header() { return m_header; }
+		DeferredContent& content() { return m_content; }
 
 		static Type& cls() { static Type ty("Tab", ScrollSheet::cls()); return ty; }
 
@@ -35,6 +39,7 @@ namespace toy
 		Tabber& m_tabber;
 		Button& m_header;
 		bool m_active;
+		DeferredContent m_content;
 	};
 
 	class _I_ TOY_UI_EXPORT TabberHead : public Container
@@ -60,6 +65,7 @@ namespace toy
 		~Tabber();
 
 		Tab& addTab(const string& name);
+		Tab& addTab(const string& name, const DeferredContent::Builder& builder, size_t releaseDelay = 0);
 		void removeTab(Tab& tab);
 
 		virtual Container& emplaceContainer();
@@ -86,7 +86,10 @@ namespace toy
 
 		virtual unique_ptr<Renderer> createRenderer(Context& context)
 		{
-			return make_unique<GlRenderer>(m_resourcePath);
+			unique_ptr<GlRenderer> renderer = make_unique<GlRenderer>(m_resourcePath);
+			if(m_sdfText)
+				renderer->enableSdfText(true);
+			return std::move(renderer);
 		}
 	};
 }
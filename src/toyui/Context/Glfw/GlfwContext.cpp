@@ -7,6 +7,7 @@
 
 #include <toyui/Input/InputDevice.h>
 #include <toyui/Gl/GlRenderer.h>
+#include <toyui/Gl/GlBatchRenderer.h>
 
 #include <GLFW/glfw3.h>
 
@@ -163,21 +164,29 @@ namespace toy
 		}
 	}
 
-	GlfwRenderWindow::GlfwRenderWindow(const string& name, int width, int height, bool autoSwap)
+	static size_t s_numGlfwWindows = 0;
+
+	GlfwRenderWindow::GlfwRenderWindow(const string& name, int width, int height, bool autoSwap, GLFWwindow* share)
 		: RenderWindow(name, width, height, 0)
 		, m_glWindow(nullptr)
 		, m_autoSwap(autoSwap)
 	{
-		this->initContext();
+		this->initContext(share);
 	}
 
 	GlfwRenderWindow::~GlfwRenderWindow()
 	{
-		glfwTerminate();
+		if(m_glWindow)
+			glfwDestroyWindow(m_glWindow);
+
+		if(--s_numGlfwWindows == 0)
+			glfwTerminate();
 	}
 
-	void GlfwRenderWindow::initContext()
+	void GlfwRenderWindow::initContext(GLFWwindow* share)
 	{
+		++s_numGlfwWindows;
+
 		if(!glfwInit()) {
 			printf("Failed to init GLFW.");
 			return;
@@ -196,7 +205,7 @@ namespace toy
 
 		//glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, 1);
 
-		m_glWindow = glfwCreateWindow(m_width, m_height, m_title.c_str(), NULL, NULL);
+		m_glWindow = glfwCreateWindow(m_width, m_height, m_title.c_str(), NULL, share);
 
 		if(!m_glWindow) {
 			glfwTerminate();
@@ -218,6 +227,18 @@ namespace toy
 #endif
 	}
 
+	void GlfwRenderWindow::makeCurrent()
+	{
+		if(glfwGetCurrentContext() != m_glWindow)
+			glfwMakeContextCurrent(m_glWindow);
+	}
+
+	void GlfwRenderWindow::setVsync(bool enabled)
+	{
+		this->makeCurrent();
+		glfwSwapInterval(enabled ? 1 : 0);
+	}
+
 	bool GlfwRenderWindow::nextFrame()
 	{
 		this->resize();
@@ -267,6 +288,16 @@ namespace toy
 		return true;
 	}
 
+	void GlfwInputWindow::waitEvents(double timeout)
+	{
+		glfwWaitEventsTimeout(timeout);
+	}
+
+	void GlfwInputWindow::wakeEvents()
+	{
+		glfwPostEmptyEvent();
+	}
+
 	void GlfwInputWindow::initInput(Mouse& mouse, Keyboard& keyboard)
 	{
 		m_mouse = &mouse;
@@ -321,10 +352,10 @@ namespace toy
 		m_mouse->dispatchMouseWheeled(m_mouseX, m_mouseY, x + y);
 	}
 
-	GlfwContext::GlfwContext(RenderSystem& renderSystem, const string& name, int width, int height, bool fullScreen, bool autoSwap)
+	GlfwContext::GlfwContext(RenderSystem& renderSystem, const string& name, int width, int height, bool fullScreen, bool autoSwap, GLFWwindow* share)
 		: Context(renderSystem)
 	{
-		unique_ptr<GlfwRenderWindow> renderWindow = make_unique<GlfwRenderWindow>(name, width, height, autoSwap);
+		unique_ptr<GlfwRenderWindow> renderWindow = make_unique<GlfwRenderWindow>(name, width, height, autoSwap, share);
 		unique_ptr<GlfwInputWindow> inputWindow = make_unique<GlfwInputWindow>(*renderWindow);
 
 		this->init(std::move(renderWindow), std::move(inputWindow));
@@ -332,15 +363,29 @@ namespace toy
 
 	GlfwRenderSystem::GlfwRenderSystem(const string& resourcePath)
 		: RenderSystem(resourcePath)
+		, m_shareWindow(nullptr)
+		, m_batchRenderer(false)
 	{}
 
 	unique_ptr<Context> GlfwRenderSystem::createContext(const string& name, int width, int height, bool fullScreen)
 	{
-		return make_unique<GlfwContext>(*this, name, width, height, fullScreen, true);
+		unique_ptr<GlfwContext> context = make_unique<GlfwContext>(*this, name, width, height, fullScreen, true, m_shareWindow);
+		if(!m_shareWindow)
+			m_shareWindow = static_cast<GlfwRenderWindow&>(context->renderWindow()).glWindow();
+		return std::move(context);
 	}
 
 	unique_ptr<Renderer> GlfwRenderSystem::createRenderer(Context& context)
 	{
-		return make_unique<GlRenderer>(m_resourcePath, true);
+		GlfwRenderWindow& renderWindow = static_cast<GlfwRenderWindow&>(context.renderWindow());
+
+		unique_ptr<GlRenderer> renderer = m_batchRenderer ? make_unique<GlBatchRenderer>(m_resourcePath, true) : make_unique<GlRenderer>(m_resourcePath, true);
+		renderer->setSharedContext(renderWindow.glWindow() != m_shareWindow);
+		if(m_sdfText)
+			renderer->enableSdfText(true);
+#ifdef TOYUI_DRAW_CACHE
+		renderer->setPartialRedraw(true);
+#endif
+		return std::move(renderer);
 	}
 }
@@ -16,14 +16,16 @@ namespace toy
 	class GlfwRenderWindow : public RenderWindow
 	{
 	public:
-		GlfwRenderWindow(const string& name, int width, int height, bool autoSwap = true);
+		GlfwRenderWindow(const string& name, int width, int height, bool autoSwap = true, GLFWwindow* share = nullptr);
 		~GlfwRenderWindow();
 
 		GLFWwindow* glWindow() { return m_glWindow; }
 
-		void initContext();
+		void initContext(GLFWwindow* share);
 
 		bool nextFrame();
+		void makeCurrent();
+		void setVsync(bool enabled);
 		void resize();
 
 	protected:
@@ -40,6 +42,8 @@ namespace toy
 		void initInput(Mouse& mouse, Keyboard& keyboard);
 
 		bool nextFrame();
+		void waitEvents(double timeout);
+		void wakeEvents();
 
 		void injectMouseMove(double x, double y);
 		void injectMouseButton(int button, int action, int mods);
@@ -63,7 +67,7 @@ namespace toy
 	class GlfwContext : public Context
 	{
 	public:
-		GlfwContext(RenderSystem& renderSystem, const string& name, int width, int height, bool fullScreen, bool autoSwap);
+		GlfwContext(RenderSystem& renderSystem, const string& name, int width, int height, bool fullScreen, bool autoSwap, GLFWwindow* share = nullptr);
 	};
 
 	class GlfwRenderSystem : public RenderSystem
@@ -73,6 +77,14 @@ namespace toy
 
 		virtual unique_ptr<Context> createContext(const string& name, int width, int height, bool fullScreen);
 		virtual unique_ptr<Renderer> createRenderer(Context& context);
+
+		// renderers created afterwards draw rects and images in vertex batches instead of nanovg paths
+		void setBatchRenderer(bool enabled) { m_batchRenderer = enabled; }
+
+	protected:
+		// every window shares its gl objects with the first one, so that textures are loaded once
+		GLFWwindow* m_shareWindow;
+		bool m_batchRenderer;
 	};
 }
 
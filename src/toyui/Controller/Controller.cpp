@@ -45,7 +45,7 @@ namespace toy
 
 	void Controller::take(Widget& inputWidget)
 	{
-		m_parentFrame = &inputWidget;
+		this->setParentFrame(&inputWidget);
 		m_inputWidget = &inputWidget;
 		InputFrame::m_controlMode = m_controlMode;
 		inputWidget.takeControl(m_controlMode, m_deviceType);
@@ -56,7 +56,7 @@ namespace toy
 	{
 		this->yieldControl();
 		m_inputWidget->yieldControl();
-		m_parentFrame = nullptr;
+		this->setParentFrame(nullptr);
 		m_inputWidget = nullptr;
 	}
 
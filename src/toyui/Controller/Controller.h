@@ -10,7 +10,7 @@
 #include <toyui/Input/InputDispatcher.h>
 
 /* std */
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 
@@ -26,7 +26,7 @@ namespace toy
 
 	protected:
 		typedef std::function<void()> KeyHandler;
-		typedef std::map<KeyCode, KeyHandler> KeyMap;
+		typedef std::unordered_map<int, KeyHandler> KeyMap;
 
 		KeyMap m_keyDownHandlers;
 		KeyMap m_keyUpHandlers;
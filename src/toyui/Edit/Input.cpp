@@ -31,8 +31,10 @@ namespace toy
 	InputDropdown::InputDropdown(Wedge& parent, const string& label, StringVector choices, std::function<void(const string&)> callback, bool reverse)
 		: WrapControl(parent, cls())
 		, m_label(*this, label)
-		, m_input(*this, [callback](Widget& widget) { if(callback) callback(widget.label()); }, choices)
+		, m_input(*this, [callback](Widget& widget) { if(callback) callback(widget.label()); })
 	{
+		m_input.deferChoices(choices);
+
 		if(reverse)
 			this->swap(0, 1);
 	}
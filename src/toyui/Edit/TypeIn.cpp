@@ -14,6 +14,8 @@
 #include <toyui/Frame/Frame.h>
 #include <toyui/Frame/Stripe.h>
 
+#include <toyui/Input/InputDevice.h>
+
 namespace toy
 {
 	TypeIn::TypeIn(Wedge& parent, string& string, Type& type)
@@ -41,10 +43,15 @@ namespace toy
 
 	void TypeIn::focused()
 	{
+		this->rootSheet().keyboard().focus().setTextInput(this);
 	}
 
 	void TypeIn::unfocused()
 	{
+		FocusManager& focus = this->rootSheet().keyboard().focus();
+		if(focus.textInput() == this)
+			focus.setTextInput(nullptr);
+
 		this->selectCaret(-1);
 	}
 
@@ -60,22 +67,26 @@ namespace toy
 
 		if(this->content().caption().selectStart() == this->content().caption().selectEnd())
 		{
-			m_string.erase(m_string.begin() + this->content().caption().selectStart() - 1);
+			size_t position = this->content().caption().selectStart() - 1;
+			m_string.erase(position, 1);
+			this->updateText(position, 1, 0);
 			this->moveCaretLeft();
 		}
 		else
 		{
-			m_string.erase(m_string.begin() + this->content().caption().selectStart(), m_string.begin() + this->content().caption().selectEnd());
-			this->moveCaretTo(this->content().caption().selectStart());
+			size_t position = this->content().caption().selectStart();
+			size_t count = this->content().caption().selectEnd() - position;
+			m_string.erase(position, count);
+			this->updateText(position, count, 0);
+			this->moveCaretTo(position);
 		}
-
-		this->updateText();
 	}
 
 	void TypeIn::insert(char c)
 	{
-		m_string.insert(m_string.begin() + this->content().caption().caret(), c);
-		this->updateText();
+		size_t position = this->content().caption().caret();
+		m_string.insert(m_string.begin() + position, c);
+		this->updateText(position, 0, 1);
 		this->moveCaretRight();
 	}
 
@@ -84,17 +95,21 @@ namespace toy
 		if(m_input)
 			m_string = m_input->getString();
 
+		// an edit made through this widget is already applied to the caption
+		if(m_string == this->content().text())
+			return;
+
 		this->content().setText(m_string);
 		this->markDirty();
 	}
 
-	void TypeIn::updateText()
+	void TypeIn::updateText(size_t position, size_t erased, size_t inserted)
 	{
+		this->content().editText(position, erased, m_string.substr(position, inserted));
+		this->markDirty();
+
 		if(m_input)
 			m_input->setString(m_string);
-
-		this->content().setText(m_string);
-		this->markDirty();
 	}
 
 	void TypeIn::leftClick(MouseEvent& mouseEvent)
@@ -32,7 +32,7 @@ namespace toy
 		void erase();
 		void insert(char c);
 		void updateString();
-		void updateText();
+		void updateText(size_t position, size_t erased, size_t inserted);
 
 		void leftClick(MouseEvent& mouseEvent);
 		void keyDown(KeyEvent& keyEvent);
@@ -10,10 +10,15 @@
 #include <toyobj/Util/StatString.h>
 
 #include <toyui/Widget/Layout.h>
+#include <toyui/Widget/RootSheet.h>
+#include <toyui/Frame/Frame.h>
 
 #include <toyui/Edit/TypeIn.h>
 #include <toyui/Button/Slider.h>
 
+/* std */
+#include <algorithm>
+
 using namespace std::placeholders;
 
 namespace toy
@@ -22,6 +27,7 @@ namespace toy
 		: m_value(value)
 		, m_update(0)
 		, m_edit(edit)
+		, m_displayedValid(false)
 		, m_onUpdate(onUpdate)
 	{}
 
@@ -30,18 +36,22 @@ namespace toy
 		, m_value(m_copy)
 		, m_update(0)
 		, m_edit(edit)
+		, m_displayedValid(false)
 		, m_onUpdate(onUpdate)
 	{}
 
 	void Value::triggerUpdate()
 	{
+		TOY_ASSERT_UI_THREAD();
 		++m_update;
+		m_displayedValid = false;
 		this->notifyUpdate();
 	}
 
 	void Value::triggerModify()
 	{
 		++m_update;
+		m_displayedValid = false;
 		this->notifyUpdate();
 		this->notifyModify();
 
@@ -63,13 +73,25 @@ namespace toy
 	WValue::WValue(Wedge& parent, Lref& value, Type& type, const OnUpdate& onUpdate, bool edit)
 		: WrapControl(parent, type)
 		, Value(value, onUpdate, edit)
+		, m_refresh(nullptr)
+		, m_pending(false)
+		, m_watched(false)
 	{}
 
 	WValue::WValue(Wedge& parent, Lref&& value, Type& type, const OnUpdate& onUpdate, bool edit)
 		: WrapControl(parent, type)
 		, Value(std::move(value), onUpdate, edit)
+		, m_refresh(nullptr)
+		, m_pending(false)
+		, m_watched(false)
 	{}
 
+	WValue::~WValue()
+	{
+		if(m_refresh)
+			m_refresh->remove(*this);
+	}
+
 	string WValue::getString()
 	{
 		size_t precision = 3;
@@ -91,4 +113,112 @@ namespace toy
 	{
 		this->markDirty();
 	}
+
+	void WValue::deferUpdate()
+	{
+		++m_update;
+		if(!m_pending)
+			this->rootSheet().valueRefresh().defer(*this);
+	}
+
+	void WValue::watch()
+	{
+		if(!m_watched)
+			this->rootSheet().valueRefresh().watch(*this);
+	}
+
+	void WValue::unwatch()
+	{
+		if(m_watched)
+			m_refresh->unwatch(*this);
+	}
+
+	bool WValue::refreshable()
+	{
+		return m_frame->visible() && !m_frame->clipped();
+	}
+
+	bool WValue::refresh()
+	{
+		string displayed = this->getString();
+		if(m_displayedValid && displayed == m_displayed)
+			return false;
+
+		this->notifyUpdate();
+		m_displayed = displayed;
+		m_displayedValid = true;
+		return true;
+	}
+
+	ValueRefresh::ValueRefresh()
+		: m_refreshed(0)
+		, m_skipped(0)
+	{}
+
+	void ValueRefresh::defer(WValue& value)
+	{
+		value.m_refresh = this;
+		value.m_pending = true;
+		m_dirty.push_back(&value);
+	}
+
+	void ValueRefresh::watch(WValue& value)
+	{
+		value.m_refresh = this;
+		value.m_watched = true;
+		m_watched.push_back(&value);
+	}
+
+	void ValueRefresh::unwatch(WValue& value)
+	{
+		value.m_watched = false;
+		m_watched.erase(std::remove(m_watched.begin(), m_watched.end(), &value), m_watched.end());
+	}
+
+	void ValueRefresh::remove(WValue& value)
+	{
+		if(value.m_watched)
+			this->unwatch(value);
+
+		if(value.m_pending)
+		{
+			m_dirty.erase(std::remove(m_dirty.begin(), m_dirty.end(), &value), m_dirty.end());
+			std::replace(m_flushing.begin(), m_flushing.end(), &value, (WValue*) nullptr);
+			value.m_pending = false;
+		}
+	}
+
+	void ValueRefresh::flush()
+	{
+		m_refreshed = 0;
+		m_skipped = 0;
+
+		// hidden or clipped values stay pending until they can be seen
+		m_flushing.swap(m_dirty);
+		for(WValue* value : m_flushing)
+		{
+			if(!value)
+				continue;
+
+			if(!value->m_watched && !value->refreshable())
+			{
+				m_dirty.push_back(value);
+				++m_skipped;
+				continue;
+			}
+
+			value->m_pending = false;
+			if(!value->m_watched && value->refresh())
+				++m_refreshed;
+		}
+		m_flushing.clear();
+
+		for(size_t i = 0; i < m_watched.size(); ++i)
+		{
+			if(!m_watched[i]->refreshable())
+				++m_skipped;
+			else if(m_watched[i]->refresh())
+				++m_refreshed;
+		}
+	}
 }
@@ -16,6 +16,7 @@
 
 /* std */
 #include <functional>
+#include <vector>
 
 namespace toy
 {
@@ -39,6 +40,9 @@ namespace toy
 		void triggerUpdate();
 		void triggerModify();
 
+		// the update is applied once at the next frame, and only if the displayed string changed
+		virtual void deferUpdate() { this->triggerUpdate(); }
+
 		virtual void notifyUpdate() {}
 		virtual void notifyModify() {}
 
@@ -48,12 +52,18 @@ namespace toy
 		template <class T>
 		void updateValue(T val) { m_value->set<T>(val); this->triggerUpdate(); }
 
+		template <class T>
+		void pushValue(T val) { m_value->set<T>(val); this->deferUpdate(); }
+
 	protected:
 		Lref m_copy;
 		Lref& m_value;
 		size_t m_update;
 		bool m_edit;
 
+		string m_displayed;
+		bool m_displayedValid;
+
 		OnUpdate m_onUpdate;
 	};
 
@@ -62,12 +72,53 @@ namespace toy
 	public:
 		WValue(Wedge& parent, Lref& lref, Type& type, const OnUpdate& onUpdate, bool edit = false);
 		WValue(Wedge& parent, Lref&& lref, Type& type, const OnUpdate& onUpdate, bool edit = false);
+		~WValue();
 
 		string getString();
 
 		void notifyUpdate();
 
+		void deferUpdate();
+
+		// poll the bound value every frame instead of waiting for it to be pushed
+		void watch();
+		void unwatch();
+
+		bool refreshable();
+		bool refresh();
+
 		static Type& cls() { static Type ty("WValue", WrapControl::cls()); return ty; }
+
+	protected:
+		ValueRefresh* m_refresh;
+		bool m_pending;
+		bool m_watched;
+
+		friend class ValueRefresh;
+	};
+
+	class TOY_UI_EXPORT ValueRefresh : public NonCopy
+	{
+	public:
+		ValueRefresh();
+
+		void defer(WValue& value);
+		void watch(WValue& value);
+		void unwatch(WValue& value);
+		void remove(WValue& value);
+
+		void flush();
+
+		size_t refreshed() { return m_refreshed; }
+		size_t skipped() { return m_skipped; }
+
+	protected:
+		std::vector<WValue*> m_dirty;
+		std::vector<WValue*> m_flushing;
+		std::vector<WValue*> m_watched;
+
+		size_t m_refreshed;
+		size_t m_skipped;
 	};
 }
 
@@ -34,6 +34,10 @@ namespace toy
 	class Mouse;
 	class MouseButton;
 
+	class InputRecorder;
+	class FocusManager;
+	class InputReplayer;
+
 	struct InputEvent;
 	struct MouseEvent;
 	struct KeyEvent;
@@ -49,6 +53,7 @@ namespace toy
 	class DrawFrame;
 	class Stencil;
 	class Caption;
+	class FontMetrics;
 
 	class Shadow;
 	class ImageSkin;
@@ -134,6 +139,7 @@ namespace toy
 	class File;
 
 	class Image;
+	struct Sprite;
 	class ImageAtlas;
 
 	class Renderer;
@@ -148,8 +154,12 @@ namespace toy
 	class RenderSystem;
 
 	class UiWindow;
+	class FrameScheduler;
+	class Animator;
+	class UiQueue;
 
 	class WValue;
+	class ValueRefresh;
 
 	class Device;
 	class DeviceType;
@@ -166,6 +176,7 @@ namespace toy
 	// Renderer
 	class NanoRenderer;
 	class GlRenderer;
+	class GlBatchRenderer;
 	
 	// Contexts
 	class GlfwRenderWindow;
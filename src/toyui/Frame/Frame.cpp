@@ -22,6 +22,8 @@ namespace toy
 	float AlignSpace[5] = { 0.f, 0.5f, 1.f, 0.f, 1.f };
 	float AlignExtent[5] = { 0.f, 0.5f, 1.f, 1.f, 0.f };
 
+	Frame::LayoutCounts Frame::sLayoutCounts = { 0, 0, 0, 0 };
+
 	Frame::Frame(Widget& widget)
 		: Uibox()
 		, d_widget(&widget)
@@ -31,6 +33,15 @@ namespace toy
 		, d_hidden(false)
 		, d_index(0, 0)
 		, d_hardClip()
+		, d_damaged(true)
+		, d_damageRect()
+		, d_measureStamp(0)
+		, d_measureStyleStamp(0)
+		, d_measured(0.f, 0.f)
+		, d_layoutSpace(-1.f, -1.f)
+		, d_layoutContent(0.f, 0.f)
+		, d_layoutSizing(SHRINK, SHRINK)
+		, d_layoutStyleStamp(0)
 	{}
 
 	Frame::Frame(Style& style, Stripe& parent)
@@ -41,6 +52,15 @@ namespace toy
 		, d_dirty(DIRTY_MAPPING)
 		, d_hidden(false)
 		, d_index(0, 0)
+		, d_damaged(true)
+		, d_damageRect()
+		, d_measureStamp(0)
+		, d_measureStyleStamp(0)
+		, d_measured(0.f, 0.f)
+		, d_layoutSpace(-1.f, -1.f)
+		, d_layoutContent(0.f, 0.f)
+		, d_layoutSizing(SHRINK, SHRINK)
+		, d_layoutStyleStamp(0)
 	{
 		this->setStyle(style);
 		parent.append(*this);
@@ -74,11 +94,44 @@ namespace toy
 		Stripe* parent = this->parent();
 		while(parent)
 		{
-			parent->setDirty(dirty);
+			parent->propagateDirty(dirty);
 			parent = parent->parent();
 		}
 	}
 
+	void Frame::updateDamage()
+	{
+		d_damaged = false;
+
+		float left = 0.f;
+		float top = 0.f;
+		float right = d_size[DIM_X];
+		float bottom = d_size[DIM_Y];
+		bool visible = true;
+
+		Frame* frame = this;
+		while(frame->frameType() < MASTER_LAYER)
+		{
+			visible &= !frame->d_hidden;
+			if(frame->d_widget)
+			{
+				left = frame->d_position[DIM_X] + left * frame->d_scale;
+				top = frame->d_position[DIM_Y] + top * frame->d_scale;
+				right = frame->d_position[DIM_X] + right * frame->d_scale;
+				bottom = frame->d_position[DIM_Y] + bottom * frame->d_scale;
+			}
+			frame = frame->d_parent;
+		}
+
+		MasterLayer& masterlayer = frame->as<MasterLayer>();
+		if(!d_damageRect.null())
+			masterlayer.damage(d_damageRect);
+
+		d_damageRect = visible ? BoxFloat(left, top, right - left, bottom - top) : BoxFloat();
+		if(!d_damageRect.null())
+			masterlayer.damage(d_damageRect);
+	}
+
 	void Frame::setStyle(Style& style, bool reset)
 	{
 		d_style = &style;
@@ -166,7 +219,7 @@ namespace toy
 	{
 		d_sizing[dim] = FIXED;
 		d_content[dim] = size;
-		if(d_style->layout().d_space != BOARD || d_size[dim] == 0.f)
+		if(d_style->layout().space() != BOARD || d_size[dim] == 0.f)
 			this->setSizeDim(dim, size);
 	}
 
@@ -186,8 +239,21 @@ namespace toy
 
 	void Frame::measureLayout()
 	{
-		d_content[DIM_X] = d_frame.extentSize(DIM_X);
-		d_content[DIM_Y] = d_frame.extentSize(DIM_Y);
+		// the extent only depends on the content and the style : it is measured again only when one of them changed
+		if(d_measureStamp != d_frame.contentStamp() || d_measureStyleStamp != d_styleStamp)
+		{
+			d_measured[DIM_X] = d_frame.extentSize(DIM_X);
+			d_measured[DIM_Y] = d_frame.extentSize(DIM_Y);
+			d_measureStamp = d_frame.contentStamp();
+			d_measureStyleStamp = d_styleStamp;
+			++sLayoutCounts.d_measured;
+		}
+		else
+		{
+			++sLayoutCounts.d_measureSkipped;
+		}
+
+		d_content = d_measured;
 	}
 	
 	void Frame::resizeLayout()
@@ -196,6 +262,22 @@ namespace toy
 	void Frame::positionLayout()
 	{}
 
+	bool Frame::layoutCached(const DimFloat& space)
+	{
+		return d_dirty < DIRTY_LAYOUT && d_layoutStyleStamp == d_styleStamp
+			&& d_layoutSpace[DIM_X] == space[DIM_X] && d_layoutSpace[DIM_Y] == space[DIM_Y]
+			&& d_layoutContent[DIM_X] == d_content[DIM_X] && d_layoutContent[DIM_Y] == d_content[DIM_Y]
+			&& d_layoutSizing[DIM_X] == d_sizing[DIM_X] && d_layoutSizing[DIM_Y] == d_sizing[DIM_Y];
+	}
+
+	void Frame::cacheLayout(const DimFloat& space)
+	{
+		d_layoutSpace = space;
+		d_layoutContent = d_content;
+		d_layoutSizing = d_sizing;
+		d_layoutStyleStamp = d_styleStamp;
+	}
+
 	void Frame::setSizeDim(Dimension dim, float size)
 	{
 		if(d_size[dim] == size)
@@ -216,6 +298,9 @@ namespace toy
 
 	void Frame::setPositionDim(Dimension dim, float position)
 	{
+		if(d_position[dim] == position)
+			return;
+
 		d_position[dim] = position;
 		//this->markDirty(DIRTY_LAYOUT);
 		this->setDirty(DIRTY_ABSOLUTE);
@@ -241,6 +326,32 @@ namespace toy
 			return d_parent ? d_parent->visible() : !d_hidden;
 	}
 
+	bool Frame::clipped()
+	{
+		float left = 0.f;
+		float top = 0.f;
+		float right = d_size[DIM_X];
+		float bottom = d_size[DIM_Y];
+
+		Frame* frame = this;
+		while(frame->d_parent)
+		{
+			if(frame->d_widget)
+			{
+				left = frame->d_position[DIM_X] + left * frame->d_scale;
+				top = frame->d_position[DIM_Y] + top * frame->d_scale;
+				right = frame->d_position[DIM_X] + right * frame->d_scale;
+				bottom = frame->d_position[DIM_Y] + bottom * frame->d_scale;
+			}
+
+			frame = frame->d_parent;
+			if(frame->clip() && (right < 0.f || bottom < 0.f || left > frame->width() || top > frame->height()))
+				return true;
+		}
+
+		return false;
+	}
+
 	void Frame::integratePosition(Frame& root, DimFloat& global)
 	{
 		if(this == &root)
@@ -12,6 +12,7 @@
 #include <toyui/Forward.h>
 #include <toyui/Frame/Uibox.h>
 #include <toyui/Render/DrawFrame.h>
+#include <toyui/UiArena.h>
 
 #include <cmath>
 
@@ -23,6 +24,8 @@ namespace toy
 		Frame(Widget& widget);
 		Frame(Style& style, Stripe& parent);
 
+		TOY_UI_ARENA_ALLOCATED
+
 		enum Dirty
 		{
 			CLEAN,				// Frame doesn't need update
@@ -66,12 +69,20 @@ namespace toy
 		void show();
 		void hide();
 
+		void setHidden(bool hidden) { d_hidden = hidden; this->setDirty(DIRTY_LAYOUT); }
+
 		bool visible();
+		bool clipped();
 
 		void clearDirty() { d_dirty = CLEAN; }
-		void setDirty(Dirty dirty) { if(dirty > d_dirty) d_dirty = dirty; }
+		void setDirty(Dirty dirty) { if(dirty > d_dirty) d_dirty = dirty; d_damaged = true; }
+		void propagateDirty(Dirty dirty) { if(dirty > d_dirty) d_dirty = dirty; }
 		void markDirty(Dirty dirty);
 
+		// the frame changed itself since its last damage update : its old and new absolute rects need repainting
+		inline bool damaged() { return d_damaged; }
+		void updateDamage();
+
 		virtual Frame* pinpoint(float x, float y, bool opaque);
 
 		void updateFixed(Dimension dim);
@@ -91,6 +102,10 @@ namespace toy
 		virtual void resizeLayout();
 		virtual void positionLayout();
 
+		// a frame resized again in the same space, with the same content, sizing and style, keeps its layout and its subtree is skipped
+		bool layoutCached(const DimFloat& space);
+		void cacheLayout(const DimFloat& space);
+
 		void setSizeDim(Dimension dim, float size);
 		void setSpanDim(Dimension dim, float span);
 		void setSpanDimDirect(Dimension dim, float span) { d_span[dim] = span; }
@@ -120,6 +135,17 @@ namespace toy
 
 		static Type& cls() { static Type ty; return ty; }
 
+		// frames laid out by the last relayout, and the ones whose cached results were reused
+		struct LayoutCounts
+		{
+			size_t d_measured;
+			size_t d_measureSkipped;
+			size_t d_resized;
+			size_t d_resizeSkipped;
+		};
+
+		static LayoutCounts sLayoutCounts;
+
 	protected:
 		Widget* d_widget;
 		DrawFrame d_frame;
@@ -129,6 +155,20 @@ namespace toy
 		Index d_index;
 
 		BoxFloat d_hardClip;
+
+		bool d_damaged;
+		BoxFloat d_damageRect;
+
+		// inputs and result of the last measure
+		size_t d_measureStamp;
+		size_t d_measureStyleStamp;
+		DimFloat d_measured;
+
+		// inputs of the last resize
+		DimFloat d_layoutSpace;
+		DimFloat d_layoutContent;
+		DimSizing d_layoutSizing;
+		size_t d_layoutStyleStamp;
 	};
 }
 
@@ -8,6 +8,9 @@
 
 #include <toyui/Widget/Sheet.h>
 
+/* std */
+#include <algorithm>
+
 namespace toy
 {
 	GridOverlay::GridOverlay(Widget& widget, Stripe& parent)
@@ -25,6 +28,7 @@ namespace toy
 	GridSubdiv::GridSubdiv(Widget& widget, Stripe& parent, size_t level, Dimension dim)
 		: Stripe(widget.fetchStyle(cls()), parent)
 		, d_level(level)
+		, d_slot(0)
 	{
 		this->setLength(dim);
 	}
@@ -109,45 +113,89 @@ namespace toy
 	{
 		printf("GridIndex : ");
 		for(size_t i : index)
-			printf("%u, ", i);
+			printf("%zu, ", i);
 		printf("\n");
 	}
 
-	Stripe& MultiGrid::appendLine(Stripe& parent, size_t level)
+	GridSubdiv& MultiGrid::appendLine(Stripe& parent, size_t level)
 	{
 		d_subdivs.emplace_back(make_unique<GridSubdiv>(*d_widget, parent, level, parent.length() == DIM_X ? DIM_Y : DIM_X));
+		d_subdivs.back()->setSlot(d_subdivs.size() - 1);
 		return *d_subdivs.back();
 	}
 
-	Stripe& MultiGrid::findLine(GridIndex index)
+	GridSubdiv& MultiGrid::insertLine(Stripe& parent, size_t index, size_t level)
+	{
+		GridSubdiv& line = this->appendLine(parent, level);
+		if(index < parent.contents().size() - 1)
+		{
+			parent.remove(line);
+			parent.insert(line, index);
+		}
+		return line;
+	}
+
+	void MultiGrid::removeLine(GridSubdiv& line)
 	{
-		printf("MultiGrid : find line");
-		this->printIndex(index);
+		Stripe& parent = *line.parent();
+		parent.remove(line);
 
-		std::reverse(index.begin(), index.end());
+		// swap with the last node so that destroying a node never walks the node list
+		size_t slot = line.slot();
+		std::swap(d_subdivs[slot], d_subdivs.back());
+		d_subdivs[slot]->setSlot(slot);
+		d_subdivs.pop_back();
 
-		Stripe* line = d_maindiv.get();
+		if(&parent != d_maindiv.get() && parent.contents().size() == 0)
+			this->removeLine(parent.as<GridSubdiv>());
+	}
+
+	GridSubdiv& MultiGrid::findLine(const GridIndex& index)
+	{
+		GridSubdiv* line = d_maindiv.get();
 		size_t level = 0;
 
-		while(index.size() > 0)
+		for(size_t subindex : index)
 		{
-			size_t subindex = index.back(); index.pop_back();
+			++level;
 			while(line->sequence().size() <= subindex)
 				this->appendLine(*line, level);
-			line = &line->contents()[subindex]->as<Stripe>();
-			++level;
+			line = &line->contents()[subindex]->as<GridSubdiv>();
 		}
 
 		return *line;
 	}
 
-	void MultiGrid::map(Frame& frame)
+	GridSubdiv& MultiGrid::placement(Frame& frame)
+	{
+		const GridIndex& index = frame.widget()->frameIndex()->get<GridIndex>();
+		auto it = d_placements.find(&frame);
+		if(it != d_placements.end() && (*it).second.d_index == index)
+			return *(*it).second.d_line;
+
+		GridSubdiv& line = this->findLine(index);
+		d_placements[&frame] = { index, &line };
+		return line;
+	}
+
+	GridIndex MultiGrid::gridIndex(GridSubdiv& line)
 	{
-		GridIndex location = frame.widget()->frameIndex()->get<GridIndex>();
+		GridIndex index(line.level());
+		for(Frame* node = &line; node != d_maindiv.get(); node = node->parent())
+			index[node->as<GridSubdiv>().level() - 1] = node->dindex(node->parent()->length());
+		return index;
+	}
 
-		Stripe& line = this->findLine(location);
+	void MultiGrid::place(Frame& frame, GridSubdiv& line)
+	{
 		line.append(frame);
 		frame.bind(line);
+		d_placements[&frame] = { frame.widget()->frameIndex()->get<GridIndex>(), &line };
+	}
+
+	void MultiGrid::map(Frame& frame)
+	{
+		this->place(frame, this->placement(frame));
 	}
 
 	void MultiGrid::unmap(Frame& frame)
@@ -163,91 +211,77 @@ namespace toy
 			if(frame.parent())
 				frame.parent()->remove(frame);
 		}
+	}
 
-		//d_subdivs.clear();
-		//d_maindiv->clear();
+	void MultiGrid::unmapped(Frame& frame)
+	{
+		// the frame is about to be destroyed, another one could be allocated at its address
+		d_placements.erase(&frame);
+		Stripe::unmapped(frame);
 	}
 
 	void MultiGrid::remove(Frame& element)
 	{
-		printf("MultiGrid : remove line\n");
-
 		Stripe& parent = *element.parent();
-		size_t index = element.dindex(parent.length());
 		parent.remove(element);
+		d_placements.erase(&element);
 
-		if(&parent == this)
-			return;
-
-		if(parent.contents().size() == 0)
-			this->remove(parent);
-		else
-			this->shift(parent.as<GridSubdiv>(), index, -1);
-	}
-
-	void MultiGrid::shift(GridSubdiv& line, size_t from, int amount)
-	{
-		size_t level = line.level() + 1;
-
-		line.visit(line, [level, from, amount](Frame& frame)
-		{
-			if(!frame.widget() || &frame.widget()->frameIndex()->type() != &typecls<GridIndex>()) // shitty way to check if we are leaf subdiv
-				return true;
-			GridIndex& index = frame.widget()->frameIndex()->ref<GridIndex>();
-			if(index[level] > from)
-				index[level] += amount;
-			return true;
-		});
+		if(&parent != this && &parent != d_maindiv.get() && parent.contents().size() == 0)
+			this->removeLine(parent.as<GridSubdiv>());
 	}
 
 	GridIndex MultiGrid::insertNextTo(Frame& frame, bool before)
 	{
-		GridSubdiv& line = frame.parent()->as<GridSubdiv>();
-		GridIndex index = frame.widget()->frameIndex()->get<GridIndex>();
-
-		size_t level = index.size() - 1;
-		size_t position = before ? index[level] - 1 : index[level];
+		GridSubdiv& line = this->placement(frame);
+		if(&line == d_maindiv.get())
+			return this->insertDivide(frame, before);
 
-		this->shift(line.parent()->as<GridSubdiv>(), position, 1);
+		Stripe& parent = *line.parent();
 
-		index[level] = before ? index[level] : index[level] + 1;
-
-		return index;
+		size_t index = line.dindex(parent.length()) + (before ? 0 : 1);
+		GridSubdiv& sibling = this->insertLine(parent, index, line.level());
+		return this->gridIndex(sibling);
 	}
 
 	GridIndex MultiGrid::insertDivide(Frame& frame, bool before)
 	{
-		GridSubdiv& line = frame.parent()->as<GridSubdiv>();
-
-		GridIndex location = frame.widget()->frameIndex()->ref<GridIndex>();
-		location.push_back(before ? 1 : 0);
+		GridSubdiv& line = this->placement(frame);
+		if(frame.parent() == &line)
+			line.remove(frame);
 
-		frame.widget()->frameIndex()->set<GridIndex>(location);
+		GridSubdiv& first = this->appendLine(line, line.level() + 1);
+		GridSubdiv& second = this->appendLine(line, line.level() + 1);
 
-		location.back() = before ? 0 : 1;
-		return location;
+		this->place(frame, before ? second : first);
+		return this->gridIndex(before ? first : second);
 	}
 
 	void MultiGrid::locate(float x, float y, GridSubdiv*& line, Frame*& prev, Frame*& next)
 	{
-		Frame* target = this->pinpoint(x, y, false);
+		DimFloat local(x, y);
+		Style& subdivStyle = d_widget->fetchStyle(GridSubdiv::cls());
+		GridSubdiv* node = d_maindiv.get();
 
-		if(&target->style() != &d_widget->fetchStyle(GridSubdiv::cls()))
-			return;
+		// descend the split tree, picking the child spanning the point in each line
+		while(node)
+		{
+			line = node;
+			node = nullptr;
 
-		line = &target->as<GridSubdiv>();
+			Dimension dim = line->length();
+			float pos = local[dim];
 
-		DimFloat local(x, y);
-		line->integratePosition(*this, local);
+			auto it = std::upper_bound(line->sequence().begin(), line->sequence().end(), pos, [dim](float pos, Frame* frame) { return pos < frame->dposition(dim); });
+			if(it != line->sequence().begin() && &(*(it - 1))->style() == &subdivStyle)
+				node = &(*(it - 1))->as<GridSubdiv>();
+		}
 
-		float pos = line->length() == DIM_X ? local.x() : local.y();
-		for(Frame* frame : line->sequence())
-			if(frame->dposition(line->length()) >= pos)
-			{
-				next = frame;
-				prev = line->before(*next);
-				break;
-			}
+		Dimension dim = line->length();
+		auto it = std::lower_bound(line->sequence().begin(), line->sequence().end(), local[dim], [dim](Frame* frame, float pos) { return frame->dposition(dim) < pos; });
+		if(it != line->sequence().end())
+		{
+			next = *it;
+			prev = line->before(*next);
+		}
 	}
 }
-
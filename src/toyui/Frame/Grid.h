@@ -8,6 +8,9 @@
 /* toy */
 #include <toyui/Frame/Stripe.h>
 
+/* std */
+#include <unordered_map>
+
 namespace toy
 {
 	class TOY_UI_EXPORT GridOverlay : public Stripe
@@ -34,6 +37,8 @@ namespace toy
 		static Type& cls() { static Type ty("GridColumn"); return ty; }
 	};
 
+	/* A node of the MultiGrid split tree : it is linked to its parent node through its parent stripe, and to its siblings through its index in it
+	 */
 	class TOY_UI_EXPORT GridSubdiv : public Stripe
 	{
 	public:
@@ -41,10 +46,14 @@ namespace toy
 
 		size_t level() { return d_level; }
 
+		size_t slot() { return d_slot; }
+		void setSlot(size_t slot) { d_slot = slot; }
+
 		static Type& cls() { static Type ty("GridSubdiv"); return ty; }
 
 	protected:
 		size_t d_level;
+		size_t d_slot;
 	};
 
 	class TOY_UI_EXPORT TableGrid : public Stripe
@@ -85,6 +94,16 @@ namespace toy
 
 	typedef std::vector<size_t> GridIndex;
 
+	struct GridPlacement
+	{
+		GridIndex d_index;
+		GridSubdiv* d_line;
+	};
+
+	/* Frames are placed in the split tree by a GridIndex path the first time they are mapped, and keep their node afterwards
+	 * Inserting or removing a node only touches its line, so the placement of the other frames never has to be rewritten
+	 * A placement is forgotten when its frame is removed, and found again when the GridIndex of its widget changes
+	 */
 	class TOY_UI_EXPORT MultiGrid : public Stripe
 	{
 	public:
@@ -92,12 +111,16 @@ namespace toy
 
 		void printIndex(const GridIndex& index);
 
-		Stripe& appendLine(Stripe& parent, size_t level);
-		Stripe& findLine(GridIndex index);
+		GridSubdiv& appendLine(Stripe& parent, size_t level);
+		GridSubdiv& insertLine(Stripe& parent, size_t index, size_t level);
+		void removeLine(GridSubdiv& line);
+
+		GridSubdiv& findLine(const GridIndex& index);
+		GridSubdiv& placement(Frame& frame);
+		GridIndex gridIndex(GridSubdiv& line);
 
 		void remove(Frame& frame);
 
-		void shift(GridSubdiv& line, size_t from, int amount);
 		GridIndex insertNextTo(Frame& frame, bool before);
 		GridIndex insertDivide(Frame& frame, bool before);
 
@@ -106,10 +129,15 @@ namespace toy
 		virtual void map(Frame& frame);
 		virtual void unmap(Frame& frame);
 		virtual void unmap();
+		virtual void unmapped(Frame& frame);
+
+	protected:
+		void place(Frame& frame, GridSubdiv& line);
 
 	protected:
 		unique_ptr<GridSubdiv> d_maindiv;
 		std::vector<unique_ptr<GridSubdiv>> d_subdivs;
+		std::unordered_map<Frame*, GridPlacement> d_placements;
 	};
 }
 
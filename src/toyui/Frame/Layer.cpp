@@ -23,6 +23,7 @@ namespace toy
 		, d_index(-1)
 		, d_z(0)
 		, d_redraw(REDRAW)
+		, d_offscreen(false)
 	{}
 
 	Layer::~Layer()
@@ -93,12 +94,19 @@ namespace toy
 
 	MasterLayer::MasterLayer(Widget& widget)
 		: Layer(widget)
+		, d_reorder(false)
+		, d_fullDamage(true)
 	{}
 
 	void MasterLayer::relayout()
 	{
+		sLayoutCounts = LayoutCounts();
+
 		this->remap();
 
+		if(d_dirty >= DIRTY_MAPPING)
+			this->damageAll();
+
 		if(d_dirty >= DIRTY_STRUCTURE || d_reorder)
 			this->reorder();
 
@@ -124,6 +132,7 @@ namespace toy
 		std::sort(d_layers.begin(), d_layers.end(), goesBefore);
 
 		d_reorder = false;
+		this->damageAll();
 
 #if 0 // DEBUG
 		for(Layer* layer: d_layers)
@@ -134,6 +143,53 @@ namespace toy
 #endif
 	}
 
+	static const size_t s_maxDamageRects = 8;
+
+	void MasterLayer::damage(const BoxFloat& rect)
+	{
+		if(d_fullDamage || rect.w() <= 0.f || rect.h() <= 0.f)
+			return;
+
+		float x0 = rect.x();
+		float y0 = rect.y();
+		float x1 = rect.x() + rect.w();
+		float y1 = rect.y() + rect.h();
+
+		// merging can make the rect overlap one it was tested against already, so start over after each merge
+		for(size_t i = 0; i < d_damage.size();)
+		{
+			BoxFloat& other = d_damage[i];
+			if(other.x() > x1 || other.y() > y1 || other.x() + other.w() < x0 || other.y() + other.h() < y0)
+			{
+				++i;
+				continue;
+			}
+
+			x0 = std::min(x0, other.x());
+			y0 = std::min(y0, other.y());
+			x1 = std::max(x1, other.x() + other.w());
+			y1 = std::max(y1, other.y() + other.h());
+			d_damage.erase(d_damage.begin() + i);
+			i = 0;
+		}
+
+		d_damage.emplace_back(x0, y0, x1 - x0, y1 - y0);
+
+		// each rect costs a pass over the layers : past a few, the region is reduced to its bounds
+		if(d_damage.size() > s_maxDamageRects)
+		{
+			for(BoxFloat& other : d_damage)
+			{
+				x0 = std::min(x0, other.x());
+				y0 = std::min(y0, other.y());
+				x1 = std::max(x1, other.x() + other.w());
+				y1 = std::max(y1, other.y() + other.h());
+			}
+			d_damage.clear();
+			d_damage.emplace_back(x0, y0, x1 - x0, y1 - y0);
+		}
+	}
+
 	Layer3D::Layer3D(Widget& widget)
 		: MasterLayer(widget)
 	{}
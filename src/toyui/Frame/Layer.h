@@ -40,6 +40,10 @@ namespace toy
 
 		void endRedraw() { d_redraw = NO_REDRAW; }
 
+		// an offscreen layer is rasterized in its own target when redrawn, and only composited when it moves
+		bool offscreen() { return d_offscreen; }
+		void setOffscreen(bool offscreen) { d_offscreen = offscreen; this->setForceRedraw(); }
+
 		void collectLayers(std::vector<Layer*>& layers, FrameType barrier = LAYER);
 
 		void remap();
@@ -56,6 +60,7 @@ namespace toy
 		size_t d_z;
 
 		Redraw d_redraw;
+		bool d_offscreen;
 
 		std::vector<Layer*> d_sublayers;
 	};
@@ -75,9 +80,20 @@ namespace toy
 		void reorder();
 		void addLayer(Layer& layer);
 
+		// damage : the absolute rects that changed since the last render, overlapping rects are merged
+		const std::vector<BoxFloat>& damage() { return d_damage; }
+		bool fullDamage() { return d_fullDamage; }
+
+		void damage(const BoxFloat& rect);
+		void damageAll() { d_fullDamage = true; }
+		void clearDamage() { d_damage.clear(); d_fullDamage = false; }
+
 	protected:
 		std::vector<Layer*> d_layers;
 		bool d_reorder;
+
+		std::vector<BoxFloat> d_damage;
+		bool d_fullDamage;
 	};
 
 	class TOY_UI_EXPORT Layer3D : public MasterLayer
@@ -57,6 +57,11 @@ namespace toy
 		this->clear();
 	}
 
+	void Stripe::unmapped(Frame& frame)
+	{
+		frame.unbind();
+	}
+
 	void Stripe::append(Frame& frame)
 	{
 		this->insert(frame, frame.flow() ? d_sequence.size() : d_contents.size());
@@ -228,6 +233,16 @@ namespace toy
 		if(frame.hidden())
 			return;
 
+		// a restructured stripe lays out all its frames, otherwise the ones given the same space as last time are skipped with their subtree
+		DimFloat space(this->frameSpace(frame, DIM_X), this->frameSpace(frame, DIM_Y));
+		if(d_dirty < DIRTY_STRUCTURE && frame.layoutCached(space))
+		{
+			++sLayoutCounts.d_resizeSkipped;
+			return;
+		}
+
+		++sLayoutCounts.d_resized;
+
 		this->resize(frame, d_length);
 		this->resize(frame, d_depth);
 
@@ -239,17 +254,23 @@ namespace toy
 		frame.content().updateContentSize();
 
 		frame.resizeLayout();
+		frame.cacheLayout(space);
 	}
 
-	void Stripe::resize(Frame& frame, Dimension dim)
+	float Stripe::frameSpace(Frame& frame, Dimension dim)
 	{
-		if(d_style->layout().layout()[dim] < AUTO_SIZE)
-			return;
-
 		float space = this->dspace(dim);
 		if(dim == d_length)
 			space = (space - d_spaceContent[dim]) * frame.dspan(d_length);
+		return space;
+	}
+
+	void Stripe::resize(Frame& frame, Dimension dim)
+	{
+		if(d_style->layout().layout()[dim] < AUTO_SIZE)
+			return;
 
+		float space = this->frameSpace(frame, dim);
 		float content = frame.dcontent(dim) + frame.dpadding(dim) + frame.dbackpadding(dim);
 		float expand = std::max(0.f, space - content);
 
@@ -48,6 +48,8 @@ namespace toy
 		virtual void unmap(Frame& frame);
 		virtual void remap();
 		virtual void unmap();
+		// a frame leaves the stripe after all of them were unmapped at once
+		virtual void unmapped(Frame& frame);
 
 		void append(Frame& frame);
 		void insert(Frame& frame, size_t index);
@@ -87,6 +89,9 @@ namespace toy
 		void resize(Frame& frame, Dimension dim);
 		void position(Frame& frame, Dimension dim);
 
+		// the space this stripe gives to the frame, the key of its layout cache
+		float frameSpace(Frame& frame, Dimension dim);
+
 		float positionFree(Frame& frame, Dimension dim, float offset, float space);
 		float positionSequence(Frame& frame, float offset, float space);
 
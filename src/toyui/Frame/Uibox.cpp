@@ -15,6 +15,7 @@ namespace toy
 		, d_span(1.f, 1.f)
 		, d_sizing(SHRINK, SHRINK)
 		, d_scale(1.f)
+		, d_alpha(1.f)
 		, d_depth(DIM_X)
 		, d_length(DIM_Y)
 		, d_style(nullptr)
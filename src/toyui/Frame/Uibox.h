@@ -50,14 +50,16 @@ namespace toy
 		inline Dimension length() { return d_length; }
 		inline Dimension depth() { return d_depth; }
 
-		inline bool flow() { return d_style->layout().d_flow == FLOW; }
-		inline bool posflow() { return d_style->layout().d_flow <= ALIGN; }
-		inline bool sizeflow() { return d_style->layout().d_flow <= OVERLAY; }
-		inline bool clip() { return d_style->layout().d_clipping == CLIP; }
+		inline bool flow() { return d_style->layout().flow() == FLOW; }
+		inline bool posflow() { return d_style->layout().flow() <= ALIGN; }
+		inline bool sizeflow() { return d_style->layout().flow() <= OVERLAY; }
+		inline bool clip() { return d_style->layout().clipping() == CLIP; }
 		inline bool opaque() { return d_opacity == OPAQUE; }
 		inline bool hollow() { return d_opacity == HOLLOW; }
 
 		inline float scale() { return d_scale; }
+		// fades the frame and its contents, multiplied with the alpha of the parents
+		inline float alpha() { return d_alpha; }
 
 		inline float left() { return dposition(DIM_X); }
 		inline float right() { return dposition(DIM_X) + dsize(DIM_X); }
@@ -74,6 +76,7 @@ namespace toy
 		inline void setLength(Dimension dim) { d_length = dim; d_depth = dim == DIM_X ? DIM_Y : DIM_X; }
 		inline void setOpacity(Opacity opacity) { d_opacity = opacity; }
 		inline void setScale(float scale) { d_scale = scale; }
+		inline void setAlpha(float alpha) { d_alpha = alpha; }
 		inline void setContentSize(DimFloat content) { d_content = content; }
 
 	protected:
@@ -85,6 +88,7 @@ namespace toy
 		DimFloat d_span;
 		DimSizing d_sizing;
 		float d_scale;
+		float d_alpha;
 		Dimension d_depth;
 		Dimension d_length;
 		Opacity d_opacity;
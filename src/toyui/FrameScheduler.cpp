@@ -0,0 +1,131 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/FrameScheduler.h>
+
+/* std */
+#include <algorithm>
+
+namespace toy
+{
+	typedef std::chrono::duration<float, std::milli> Milliseconds;
+	typedef std::chrono::duration<double> Seconds;
+
+	FrameScheduler::FrameScheduler()
+		: m_targetRate(60.f)
+		, m_idleRate(10.f)
+		, m_idleDelay(0.5f)
+		, m_budget(0.f)
+		, m_vsync(true)
+		, m_vsyncChanged(true)
+		, m_adaptive(true)
+		, m_idle(false)
+		, m_frameStart(std::chrono::steady_clock::now())
+		, m_workEnd(m_frameStart)
+		, m_lastWake(m_frameStart)
+		, m_lastId(0)
+		, m_frameIndex(0)
+		, m_lateFrames(0)
+		, m_timings(s_timingHistory, FrameTiming{ 0, 0.f, 0.f, false, false })
+	{}
+
+	float FrameScheduler::budget() const
+	{
+		if(m_budget > 0.f)
+			return m_budget;
+		return m_targetRate > 0.f ? 1000.f / m_targetRate : 1000.f / 60.f;
+	}
+
+	void FrameScheduler::wake()
+	{
+		m_lastWake = std::chrono::steady_clock::now();
+		m_idle = false;
+	}
+
+	FrameScheduler::CallbackId FrameScheduler::schedule(float delay, const Callback& callback, bool repeat)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(Seconds(delay));
+		m_scheduled.push_back(Scheduled{ ++m_lastId, deadline, delay, repeat, callback });
+		return m_lastId;
+	}
+
+	void FrameScheduler::cancel(CallbackId id)
+	{
+		// only cleared here, the entry is removed after the callbacks ran so that a callback can cancel another
+		for(Scheduled& scheduled : m_scheduled)
+			if(scheduled.d_id == id)
+				scheduled.d_callback = nullptr;
+	}
+
+	void FrameScheduler::runScheduled(TimePoint now)
+	{
+		// callbacks can schedule new ones : iterate by index over the entries present at the start
+		size_t count = m_scheduled.size();
+		for(size_t i = 0; i < count; ++i)
+		{
+			if(!m_scheduled[i].d_callback || m_scheduled[i].d_deadline > now)
+				continue;
+
+			Callback callback = m_scheduled[i].d_callback;
+			if(m_scheduled[i].d_repeat)
+				m_scheduled[i].d_deadline = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(Seconds(m_scheduled[i].d_delay));
+			else
+				m_scheduled[i].d_callback = nullptr;
+
+			// a scheduled callback usually changes something on screen
+			this->wake();
+			callback();
+		}
+
+		m_scheduled.erase(std::remove_if(m_scheduled.begin(), m_scheduled.end(), [](const Scheduled& scheduled) { return !scheduled.d_callback; }), m_scheduled.end());
+	}
+
+	void FrameScheduler::beginFrame()
+	{
+		TimePoint now = std::chrono::steady_clock::now();
+
+		FrameTiming& timing = m_timings[m_frameIndex % s_timingHistory];
+		timing.d_frame = m_frameIndex;
+		timing.d_interval = Milliseconds(now - m_frameStart).count();
+
+		m_frameStart = now;
+		this->runScheduled(now);
+	}
+
+	void FrameScheduler::presentFrame()
+	{
+		m_workEnd = std::chrono::steady_clock::now();
+	}
+
+	double FrameScheduler::endFrame()
+	{
+		TimePoint now = std::chrono::steady_clock::now();
+
+		FrameTiming& timing = m_timings[m_frameIndex % s_timingHistory];
+		timing.d_work = Milliseconds(m_workEnd - m_frameStart).count();
+		timing.d_late = timing.d_work > this->budget();
+		timing.d_idle = m_idle;
+
+		if(timing.d_late)
+			++m_lateFrames;
+		++m_frameIndex;
+
+		m_idle = m_adaptive && Seconds(now - m_lastWake).count() > m_idleDelay;
+
+		float rate = m_idle ? m_idleRate : m_targetRate;
+
+		// at full rate with vsync on, the buffer swap already waits for the display
+		if(rate <= 0.f || (m_vsync && !m_idle))
+			return 0.0;
+
+		double wait = 1.0 / rate - Seconds(now - m_frameStart).count();
+
+		for(Scheduled& scheduled : m_scheduled)
+			if(scheduled.d_callback)
+				wait = std::min(wait, Seconds(scheduled.d_deadline - now).count());
+
+		return std::max(wait, 0.0);
+	}
+}
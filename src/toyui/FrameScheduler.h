@@ -0,0 +1,115 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_FRAMESCHEDULER_H
+#define TOY_FRAMESCHEDULER_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyui/Forward.h>
+
+/* std */
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+namespace toy
+{
+	struct TOY_UI_EXPORT FrameTiming
+	{
+		size_t d_frame;
+		// milliseconds spent rendering and updating, and from the start of the previous frame to the start of this one
+		float d_work;
+		float d_interval;
+		bool d_late;
+		bool d_idle;
+	};
+
+	/* Paces the frames of a window : a target rate with or without vsync, lowered to an idle rate when nothing happened for a while
+	 * Input and animations wake the scheduler back to full rate, frames taking longer than the budget are counted as late
+	 * Callbacks scheduled after a delay run at the start of the first frame past their deadline, and shorten the idle wait to meet it
+	 */
+	class TOY_UI_EXPORT FrameScheduler : public NonCopy
+	{
+	public:
+		typedef std::chrono::steady_clock::time_point TimePoint;
+		typedef std::function<void()> Callback;
+		typedef uint32_t CallbackId;
+
+		static const size_t s_timingHistory = 240;
+
+	public:
+		FrameScheduler();
+
+		float targetRate() const { return m_targetRate; }
+		float idleRate() const { return m_idleRate; }
+		bool vsync() const { return m_vsync; }
+		bool adaptive() const { return m_adaptive; }
+
+		// a rate of zero disables the pacing, frames are then only limited by vsync
+		void setTargetRate(float fps) { m_targetRate = fps; }
+		void setIdleRate(float fps) { m_idleRate = fps; }
+		void setVsync(bool enabled) { m_vsync = enabled; m_vsyncChanged = true; }
+		void setAdaptive(bool adaptive, float idleDelay = 0.5f) { m_adaptive = adaptive; m_idleDelay = idleDelay; }
+
+		// the budget defaults to the duration of a frame at the target rate
+		float budget() const;
+		void setBudget(float ms) { m_budget = ms; }
+
+		bool idle() const { return m_idle; }
+		void wake();
+
+		CallbackId schedule(float delay, const Callback& callback, bool repeat = false);
+		void cancel(CallbackId id);
+
+		void beginFrame();
+		// the work of the frame ends before the buffers are swapped, which can block on vsync
+		void presentFrame();
+		// the time left to wait before the next frame, in seconds
+		double endFrame();
+
+		bool vsyncChanged() { bool changed = m_vsyncChanged; m_vsyncChanged = false; return changed; }
+
+		size_t frameIndex() const { return m_frameIndex; }
+		size_t lateFrames() const { return m_lateFrames; }
+		const FrameTiming& lastTiming() const { return m_timings[(m_frameIndex + s_timingHistory - 1) % s_timingHistory]; }
+		const std::vector<FrameTiming>& timings() const { return m_timings; }
+
+	protected:
+		struct Scheduled
+		{
+			CallbackId d_id;
+			TimePoint d_deadline;
+			float d_delay;
+			bool d_repeat;
+			Callback d_callback;
+		};
+
+		void runScheduled(TimePoint now);
+
+	protected:
+		float m_targetRate;
+		float m_idleRate;
+		float m_idleDelay;
+		float m_budget;
+		bool m_vsync;
+		bool m_vsyncChanged;
+		bool m_adaptive;
+		bool m_idle;
+
+		TimePoint m_frameStart;
+		TimePoint m_workEnd;
+		TimePoint m_lastWake;
+
+		std::vector<Scheduled> m_scheduled;
+		CallbackId m_lastId;
+
+		size_t m_frameIndex;
+		size_t m_lateFrames;
+		std::vector<FrameTiming> m_timings;
+	};
+}
+
+#endif // TOY_FRAMESCHEDULER_H
@@ -0,0 +1,537 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Gl/GlBatchRenderer.h>
+
+#include <toyui/Style/Style.h>
+#include <toyui/ImageAtlas.h>
+
+#ifdef NANOVG_GLEW
+	#include <GL/glew.h>
+#elif defined TOY_PLATFORM_EMSCRIPTEN
+	#define GL_GLEXT_PROTOTYPES
+	#include <GL/gl.h>
+	#include <GL/glext.h>
+#endif
+
+#ifdef TOY_PLATFORM_EMSCRIPTEN
+#define NANOVG_GLES2 1
+#else
+#define NANOVG_GL3 1
+#endif
+
+#include <nanovg.h>
+#include <nanovg_gl.h>
+
+#include <cstddef>
+#include <algorithm>
+
+namespace toy
+{
+	static const char* s_batchVertexShader =
+		"uniform vec2 u_viewSize;\n"
+		"uniform vec2 u_offset;\n"
+		"ATTRIBUTE vec2 a_position;\n"
+		"ATTRIBUTE vec2 a_uv;\n"
+		"ATTRIBUTE vec2 a_local;\n"
+		"ATTRIBUTE vec2 a_halfSize;\n"
+		"ATTRIBUTE vec4 a_radii;\n"
+		"ATTRIBUTE vec4 a_colour;\n"
+		"ATTRIBUTE vec4 a_borderColour;\n"
+		"ATTRIBUTE vec4 a_params;\n"
+		"VARYING_VS vec2 v_uv;\n"
+		"VARYING_VS vec2 v_local;\n"
+		"VARYING_VS vec2 v_halfSize;\n"
+		"VARYING_VS vec4 v_radii;\n"
+		"VARYING_VS vec4 v_colour;\n"
+		"VARYING_VS vec4 v_borderColour;\n"
+		"VARYING_VS vec4 v_params;\n"
+		"void main() {\n"
+		"	v_uv = a_uv;\n"
+		"	v_local = a_local;\n"
+		"	v_halfSize = a_halfSize;\n"
+		"	v_radii = a_radii;\n"
+		"	v_colour = a_colour;\n"
+		"	v_borderColour = a_borderColour;\n"
+		"	v_params = a_params;\n"
+		"	vec2 position = a_position + u_offset;\n"
+		"	gl_Position = vec4(2.0 * position.x / u_viewSize.x - 1.0, 1.0 - 2.0 * position.y / u_viewSize.y, 0.0, 1.0);\n"
+		"}\n";
+
+	// distance to a rounded rect with one radius per corner, in screen pixels : coverage ramps over the feather around the edge
+	static const char* s_batchFragmentShader =
+		"uniform sampler2D u_image;\n"
+		"VARYING_FS vec2 v_uv;\n"
+		"VARYING_FS vec2 v_local;\n"
+		"VARYING_FS vec2 v_halfSize;\n"
+		"VARYING_FS vec4 v_radii;\n"
+		"VARYING_FS vec4 v_colour;\n"
+		"VARYING_FS vec4 v_borderColour;\n"
+		"VARYING_FS vec4 v_params;\n"
+		"void main() {\n"
+		"	float radius = v_local.x < 0.0 ? (v_local.y < 0.0 ? v_radii.x : v_radii.w) : (v_local.y < 0.0 ? v_radii.y : v_radii.z);\n"
+		"	vec2 d = abs(v_local) - v_halfSize + vec2(radius);\n"
+		"	float distance = min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - radius;\n"
+		"	float coverage = clamp(0.5 - distance / max(v_params.y, 1.0), 0.0, 1.0);\n"
+		"	vec4 colour = v_colour;\n"
+		"	if(v_params.z > 0.5)\n"
+		"		colour *= TEXTURE(u_image, v_uv);\n"
+		"	if(v_params.x > 0.0)\n"
+		"		colour = mix(colour, v_borderColour, clamp(distance + v_params.x + 0.5, 0.0, 1.0));\n"
+		"	float alpha = colour.a * coverage;\n"
+		"	outColour = vec4(colour.rgb * alpha, alpha);\n"
+		"}\n";
+
+	inline float lerp(float a, float b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	inline Colour offsetColour(const Colour& colour, float delta)
+	{
+		float offset = delta / 255.0f;
+		return Colour(std::min(std::max(colour.r() + offset, 0.f), 1.f),
+					  std::min(std::max(colour.g() + offset, 0.f), 1.f),
+					  std::min(std::max(colour.b() + offset, 0.f), 1.f),
+					  colour.a());
+	}
+
+	GlBatchRenderer::GlBatchRenderer(const string& resourcePath, bool clear)
+		: GlRenderer(resourcePath, clear)
+		, m_batchProgram(0)
+		, m_batchVertexArray(0)
+		, m_batchVertexBuffer(0)
+		, m_batchViewSize(-1)
+		, m_batchOffset(-1)
+		, m_quadLayers()
+		, m_quadLayer(nullptr)
+	{}
+
+	GlBatchRenderer::~GlBatchRenderer()
+	{}
+
+	void GlBatchRenderer::releaseContext()
+	{
+		for(auto& kv : m_quadLayers)
+			for(QuadSegment& segment : kv.second.d_segments)
+				if(segment.d_paths)
+					nvgDeleteDisplayList(segment.d_paths);
+
+		m_quadLayers.clear();
+		m_quadLayer = nullptr;
+
+		if(m_batchProgram)
+		{
+			glDeleteProgram(m_batchProgram);
+			glDeleteBuffers(1, &m_batchVertexBuffer);
+#if NANOVG_GL3
+			glDeleteVertexArrays(1, &m_batchVertexArray);
+#endif
+			m_batchProgram = 0;
+		}
+
+		GlRenderer::releaseContext();
+	}
+
+#ifdef TOYUI_DRAW_CACHE
+	void GlBatchRenderer::beginUpdate(void* layerCache, float x, float y, float scale)
+	{
+		GlRenderer::beginUpdate(layerCache, x, y, scale);
+		m_quadLayer = &this->quadLayer(layerCache);
+
+		// the frames of a layer are updated one after the other : the next paths go after the quads already recorded
+		if(m_quadLayer->current().d_paths)
+			nvgBindDisplayList(m_ctx, m_quadLayer->current().d_paths);
+	}
+
+	void GlBatchRenderer::endUpdate()
+	{
+		GlRenderer::endUpdate();
+		m_quadLayer = nullptr;
+	}
+#endif
+
+	QuadLayer& GlBatchRenderer::quadLayer(void* layerCache)
+	{
+		QuadLayer& layer = m_quadLayers[layerCache];
+		if(layer.d_segments.empty())
+		{
+			layer.d_segments.push_back({ nullptr, QuadBatch() });
+			layer.d_count = 1;
+		}
+		return layer;
+	}
+
+	void GlBatchRenderer::breakBatches()
+	{
+		QuadLayer& layer = m_quadLayer ? *m_quadLayer : this->quadLayer(nullptr);
+		if(layer.current().d_quads.empty())
+			return;
+
+		// the path goes in the next segment, over the quads recorded until now
+		if(layer.d_count == layer.d_segments.size())
+			layer.d_segments.push_back({ nvgCreateDisplayList(-1), QuadBatch() });
+
+		++layer.d_count;
+		nvgBindDisplayList(m_ctx, layer.current().d_paths);
+	}
+
+	bool GlBatchRenderer::batchable(float* transform, BoxFloat& scissor)
+	{
+		nvgCurrentTransform(m_ctx, transform);
+		nvgCurrentScissor(m_ctx, scissor.pointer());
+
+		// rotated or skewed shapes are left to nanovg
+		return transform[1] == 0.f && transform[2] == 0.f;
+	}
+
+	unsigned int GlBatchRenderer::imageTexture(int image)
+	{
+#if NANOVG_GL2
+		return nvglImageHandleGL2(m_ctx, image);
+#elif NANOVG_GL3
+		return nvglImageHandleGL3(m_ctx, image);
+#elif NANOVG_GLES2
+		return nvglImageHandleGLES2(m_ctx, image);
+#endif
+	}
+
+	void GlBatchRenderer::emitQuad(const Quad& quad)
+	{
+		float t[6];
+		BoxFloat scissor;
+		this->batchable(t, scissor);
+
+		const BoxFloat& rect = quad.d_rect;
+		float x0 = rect.x(), y0 = rect.y(), x1 = rect.x() + rect.w(), y1 = rect.y() + rect.h();
+
+		// clipping is done here, so that a whole layer is drawn without any scissor change
+		if(scissor.w() >= 0.f && scissor.h() >= 0.f)
+		{
+			x0 = std::max(x0, scissor.x());
+			y0 = std::max(y0, scissor.y());
+			x1 = std::min(x1, scissor.x() + scissor.w());
+			y1 = std::min(y1, scissor.y() + scissor.h());
+		}
+
+		if(x0 >= x1 || y0 >= y1)
+			return;
+
+		QuadBatch& batch = (m_quadLayer ? *m_quadLayer : this->quadLayer(nullptr)).current().d_quads;
+
+		// solid quads join any draw, a textured quad only breaks the batch when the texture changes
+		unsigned int texture = quad.d_texture;
+		if(batch.d_draws.empty() || (texture && batch.d_draws.back().d_texture && batch.d_draws.back().d_texture != texture))
+			batch.d_draws.push_back({ texture, batch.d_vertices.size(), 0 });
+		else if(texture)
+			batch.d_draws.back().d_texture = texture;
+
+		float scale = t[0];
+		float alpha = this->alpha();
+		float centerX = quad.d_shape.x() + quad.d_shape.w() * 0.5f;
+		float centerY = quad.d_shape.y() + quad.d_shape.h() * 0.5f;
+		const BoxFloat& corners = quad.d_corners;
+
+		auto vertex = [&](float px, float py) {
+			float fx = (px - rect.x()) / rect.w();
+			float fy = (py - rect.y()) / rect.h();
+			float f = quad.d_gradientDim == DIM_X ? fx : fy;
+
+			QuadVertex out;
+			out.x = t[0] * px + t[4];
+			out.y = t[3] * py + t[5];
+			out.u = lerp(quad.d_uv.x0(), quad.d_uv.x1(), fx);
+			out.v = lerp(quad.d_uv.y0(), quad.d_uv.y1(), fy);
+			out.lx = (px - centerX) * t[0];
+			out.ly = (py - centerY) * t[3];
+			out.hw = quad.d_shape.w() * 0.5f * t[0];
+			out.hh = quad.d_shape.h() * 0.5f * t[3];
+			out.radii[0] = corners.xx() * scale;
+			out.radii[1] = corners.xy() * scale;
+			out.radii[2] = corners.yx() * scale;
+			out.radii[3] = corners.yy() * scale;
+			out.r = lerp(quad.d_colour.r(), quad.d_endColour.r(), f);
+			out.g = lerp(quad.d_colour.g(), quad.d_endColour.g(), f);
+			out.b = lerp(quad.d_colour.b(), quad.d_endColour.b(), f);
+			out.a = lerp(quad.d_colour.a(), quad.d_endColour.a(), f) * alpha;
+			out.br = quad.d_borderColour.r();
+			out.bg = quad.d_borderColour.g();
+			out.bb = quad.d_borderColour.b();
+			out.ba = quad.d_borderColour.a() * alpha;
+			out.border = quad.d_border * scale;
+			out.feather = quad.d_feather * scale;
+			out.textured = texture ? 1.f : 0.f;
+			out.pad = 0.f;
+			batch.d_vertices.push_back(out);
+		};
+
+		vertex(x0, y0); vertex(x1, y0); vertex(x1, y1);
+		vertex(x0, y0); vertex(x1, y1); vertex(x0, y1);
+		batch.d_draws.back().d_count += 6;
+	}
+
+	void GlBatchRenderer::drawRect(const BoxFloat& rect, const BoxFloat& corners, InkStyle& skin)
+	{
+		float transform[6];
+		BoxFloat scissor;
+		if(!this->batchable(transform, scissor))
+		{
+			GlRenderer::drawRect(rect, corners, skin);
+			return;
+		}
+
+		float border = skin.borderWidth().x0();
+		if(skin.backgroundColour().a() <= 0.f && border <= 0.f)
+			return;
+
+		Quad quad;
+		quad.d_rect = rect;
+		quad.d_shape = rect;
+		quad.d_corners = corners;
+		quad.d_uv = BoxFloat(0.f, 0.f, 0.f, 0.f);
+		quad.d_colour = skin.backgroundColour();
+		quad.d_endColour = skin.backgroundColour();
+		quad.d_gradientDim = DIM_X;
+		quad.d_borderColour = skin.borderColour();
+		quad.d_border = border;
+		quad.d_feather = 1.f;
+		quad.d_texture = 0;
+
+		// linear gradients are along one axis of the rect : the vertex colours interpolate them
+		if(!skin.linearGradient().null())
+		{
+			quad.d_colour = offsetColour(skin.backgroundColour(), skin.linearGradient().x());
+			quad.d_endColour = offsetColour(skin.backgroundColour(), skin.linearGradient().y());
+			quad.d_gradientDim = skin.linearGradientDim();
+		}
+
+		this->emitQuad(quad);
+	}
+
+	void GlBatchRenderer::drawImage(const Image& image, const BoxFloat& rect)
+	{
+		if(image.d_atlas)
+		{
+			this->drawSprite(Sprite(image), rect);
+			return;
+		}
+
+		float transform[6];
+		BoxFloat scissor;
+		if(!this->batchable(transform, scissor))
+		{
+			GlRenderer::drawImage(image, rect);
+			return;
+		}
+
+		Quad quad;
+		quad.d_rect = rect;
+		quad.d_shape = rect;
+		quad.d_corners = BoxFloat(0.f);
+		quad.d_uv = BoxFloat(0.f, 0.f, 1.f, 1.f);
+		quad.d_colour = Colour(1.f, 1.f, 1.f, 1.f);
+		quad.d_endColour = quad.d_colour;
+		quad.d_gradientDim = DIM_X;
+		quad.d_border = 0.f;
+		quad.d_feather = 1.f;
+		quad.d_texture = this->imageTexture(this->imageIndex(image));
+
+		this->emitQuad(quad);
+	}
+
+	void GlBatchRenderer::drawSprite(const Sprite& sprite, const BoxFloat& rect, float xstretch, float ystretch)
+	{
+		float transform[6];
+		BoxFloat scissor;
+		if(!this->batchable(transform, scissor))
+		{
+			GlRenderer::drawSprite(sprite, rect, xstretch, ystretch);
+			return;
+		}
+
+		Quad quad;
+		quad.d_rect = rect;
+		quad.d_shape = rect;
+		quad.d_corners = BoxFloat(0.f);
+		quad.d_colour = Colour(1.f, 1.f, 1.f, 1.f);
+		quad.d_endColour = quad.d_colour;
+		quad.d_gradientDim = DIM_X;
+		quad.d_border = 0.f;
+		quad.d_feather = 1.f;
+
+		// same mapping as the nanovg image pattern : the sprite is anchored at the top left of the rect
+		if(sprite.d_atlas)
+		{
+			Image& atlas = sprite.d_atlas->image();
+			float width = float(atlas.d_width);
+			float height = float(atlas.d_height);
+			quad.d_uv = BoxFloat(sprite.d_left / width, sprite.d_top / height, (sprite.d_left + rect.w() / xstretch) / width, (sprite.d_top + rect.h() / ystretch) / height);
+			quad.d_texture = this->imageTexture(this->imageIndex(atlas));
+		}
+		else
+		{
+			quad.d_uv = BoxFloat(0.f, 0.f, rect.w() / (sprite.d_width * xstretch), rect.h() / (sprite.d_height * ystretch));
+			quad.d_texture = this->imageTexture(sprite.d_index);
+		}
+
+		this->emitQuad(quad);
+	}
+
+	void GlBatchRenderer::drawImageRegion(int image, float imageWidth, float imageHeight, const BoxFloat& source, const BoxFloat& dest)
+	{
+		float transform[6];
+		BoxFloat scissor;
+		if(!this->batchable(transform, scissor))
+		{
+			GlRenderer::drawImageRegion(image, imageWidth, imageHeight, source, dest);
+			return;
+		}
+
+		Quad quad;
+		quad.d_rect = dest;
+		quad.d_shape = dest;
+		quad.d_corners = BoxFloat(0.f);
+		quad.d_uv = BoxFloat(source.x() / imageWidth, source.y() / imageHeight, (source.x() + source.w()) / imageWidth, (source.y() + source.h()) / imageHeight);
+		quad.d_colour = Colour(1.f, 1.f, 1.f, 1.f);
+		quad.d_endColour = quad.d_colour;
+		quad.d_gradientDim = DIM_X;
+		quad.d_border = 0.f;
+		quad.d_feather = 1.f;
+		quad.d_texture = this->imageTexture(image);
+
+		this->emitQuad(quad);
+	}
+
+	void GlBatchRenderer::clearBatches(void* layerCache)
+	{
+		GlRenderer::clearBatches(layerCache);
+
+		QuadLayer& layer = this->quadLayer(layerCache);
+		for(size_t i = 0; i < layer.d_count; ++i)
+		{
+			QuadSegment& segment = layer.d_segments[i];
+			segment.d_quads.clear();
+			if(segment.d_paths)
+				nvgResetDisplayList(segment.d_paths);
+		}
+		layer.d_count = 1;
+	}
+
+	void GlBatchRenderer::flushBatches(void* layerCache, float width, float height, float x, float y)
+	{
+		// without the layer cache the last segment is still bound to the frame
+		nvgBindDisplayList(m_ctx, nullptr);
+
+		// the paths of the first segment were drawn with the layer
+		QuadLayer& layer = this->quadLayer(layerCache);
+		for(size_t i = 0; i < layer.d_count; ++i)
+		{
+			QuadSegment& segment = layer.d_segments[i];
+			if(segment.d_paths)
+			{
+				nvgSave(m_ctx);
+				nvgTranslate(m_ctx, x, y);
+				nvgDrawDisplayList(m_ctx, segment.d_paths);
+				nvgRestore(m_ctx);
+			}
+
+			if(segment.d_quads.empty())
+				continue;
+
+			// nanovg only draws on end frame : flush it so that the quads go on top of the paths before them
+			nvgEndFrame(m_ctx);
+			this->drawBatch(segment.d_quads, width, height, x, y);
+			this->countBatch(segment.d_quads.d_draws.size(), segment.d_quads.d_vertices.size() / 6);
+			nvgBeginFrame(m_ctx, width, height, 1.f);
+		}
+
+		GlRenderer::flushBatches(layerCache, width, height, x, y);
+	}
+
+	void GlBatchRenderer::setupBatch()
+	{
+		GLuint vertexShader = compileShader(GL_VERTEX_SHADER, s_batchVertexShader);
+		GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, s_batchFragmentShader);
+
+		m_batchProgram = glCreateProgram();
+		glAttachShader(m_batchProgram, vertexShader);
+		glAttachShader(m_batchProgram, fragmentShader);
+		glBindAttribLocation(m_batchProgram, 0, "a_position");
+		glBindAttribLocation(m_batchProgram, 1, "a_uv");
+		glBindAttribLocation(m_batchProgram, 2, "a_local");
+		glBindAttribLocation(m_batchProgram, 3, "a_halfSize");
+		glBindAttribLocation(m_batchProgram, 4, "a_radii");
+		glBindAttribLocation(m_batchProgram, 5, "a_colour");
+		glBindAttribLocation(m_batchProgram, 6, "a_borderColour");
+		glBindAttribLocation(m_batchProgram, 7, "a_params");
+#if NANOVG_GL3
+		glBindFragDataLocation(m_batchProgram, 0, "outColour");
+#endif
+		glLinkProgram(m_batchProgram);
+
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+
+		m_batchViewSize = glGetUniformLocation(m_batchProgram, "u_viewSize");
+		m_batchOffset = glGetUniformLocation(m_batchProgram, "u_offset");
+		glUseProgram(m_batchProgram);
+		glUniform1i(glGetUniformLocation(m_batchProgram, "u_image"), 0);
+
+#if NANOVG_GL3
+		glGenVertexArrays(1, &m_batchVertexArray);
+#endif
+		glGenBuffers(1, &m_batchVertexBuffer);
+	}
+
+	void GlBatchRenderer::drawBatch(const QuadBatch& batch, float width, float height, float x, float y)
+	{
+		if(!m_batchProgram)
+			this->setupBatch();
+
+		glUseProgram(m_batchProgram);
+		glUniform2f(m_batchViewSize, width, height);
+		glUniform2f(m_batchOffset, x, y);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_CULL_FACE);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_STENCIL_TEST);
+		glDisable(GL_SCISSOR_TEST);
+
+#if NANOVG_GL3
+		glBindVertexArray(m_batchVertexArray);
+#endif
+		glBindBuffer(GL_ARRAY_BUFFER, m_batchVertexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, batch.d_vertices.size() * sizeof(QuadVertex), batch.d_vertices.data(), GL_STREAM_DRAW);
+
+		for(GLuint attribute = 0; attribute < 8; ++attribute)
+			glEnableVertexAttribArray(attribute);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, x));
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, u));
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, lx));
+		glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, hw));
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, radii));
+		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, r));
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, br));
+		glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (const GLvoid*)offsetof(QuadVertex, border));
+
+		glActiveTexture(GL_TEXTURE0);
+		for(const QuadDraw& draw : batch.d_draws)
+		{
+			glBindTexture(GL_TEXTURE_2D, draw.d_texture);
+			glDrawArrays(GL_TRIANGLES, GLint(draw.d_first), GLsizei(draw.d_count));
+		}
+
+		for(GLuint attribute = 0; attribute < 8; ++attribute)
+			glDisableVertexAttribArray(attribute);
+#if NANOVG_GL3
+		glBindVertexArray(0);
+#endif
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glUseProgram(0);
+	}
+}
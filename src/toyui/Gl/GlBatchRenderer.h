@@ -0,0 +1,131 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_GLBATCHRENDERER_H
+#define TOY_GLBATCHRENDERER_H
+
+/* toy */
+#include <toyui/Forward.h>
+#include <toyui/Gl/GlRenderer.h>
+
+#include <toyobj/Util/Colour.h>
+
+/* std */
+#include <vector>
+#include <map>
+
+namespace toy
+{
+	struct QuadVertex
+	{
+		float x, y;
+		float u, v;
+		// position relative to the center of the shape, and its half size
+		float lx, ly;
+		float hw, hh;
+		float radii[4];
+		float r, g, b, a;
+		float br, bg, bb, ba;
+		float border, feather, textured, pad;
+	};
+
+	struct QuadDraw
+	{
+		unsigned int d_texture;
+		size_t d_first;
+		size_t d_count;
+	};
+
+	struct QuadBatch
+	{
+		std::vector<QuadVertex> d_vertices;
+		std::vector<QuadDraw> d_draws;
+
+		bool empty() const { return d_vertices.empty(); }
+		void clear() { d_vertices.clear(); d_draws.clear(); }
+	};
+
+	// the nanovg paths recorded after the quads of the previous segment, then the quads drawn over them
+	struct QuadSegment
+	{
+		NVGdisplayList* d_paths;
+		QuadBatch d_quads;
+	};
+
+	/* The quads of a layer, split wherever a nanovg path was drawn after some of them
+	 * The paths of the first segment are in the display list of the layer, the segments past the count are kept for reuse
+	 */
+	struct QuadLayer
+	{
+		std::vector<QuadSegment> d_segments;
+		size_t d_count;
+
+		QuadSegment& current() { return d_segments[d_count - 1]; }
+	};
+
+	/* Gl renderer drawing the axis aligned rects, rounded rects, shadow slices and images in vertex batches
+	 * The shapes are evaluated as distance fields in one shader, a batch is drawn in one call per texture it uses
+	 * Lines, curves, text and anything drawn under a rotation still go through nanovg : a path drawn after some quads
+	 * starts a new segment of the layer, and the segments are replayed in order, so nothing is drawn under the quads before it
+	 */
+	class TOY_UI_EXPORT GlBatchRenderer : public GlRenderer
+	{
+	public:
+		GlBatchRenderer(const string& resourcePath, bool clear);
+		~GlBatchRenderer();
+
+		virtual void releaseContext();
+
+#ifdef TOYUI_DRAW_CACHE
+		virtual void beginUpdate(void* layerCache, float x, float y, float scale);
+		virtual void endUpdate();
+#endif
+
+		virtual void drawRect(const BoxFloat& rect, const BoxFloat& corners, InkStyle& skin);
+		virtual void drawImage(const Image& image, const BoxFloat& rect);
+		virtual void drawSprite(const Sprite& sprite, const BoxFloat& rect, float xstretch = 1.f, float ystretch = 1.f);
+
+	protected:
+		struct Quad
+		{
+			BoxFloat d_rect;
+			BoxFloat d_shape;
+			BoxFloat d_corners;
+			BoxFloat d_uv;
+			Colour d_colour;
+			Colour d_endColour;
+			Dimension d_gradientDim;
+			Colour d_borderColour;
+			float d_border;
+			float d_feather;
+			unsigned int d_texture;
+		};
+
+		virtual void drawImageRegion(int image, float imageWidth, float imageHeight, const BoxFloat& source, const BoxFloat& dest);
+
+		virtual void flushBatches(void* layerCache, float width, float height, float x = 0.f, float y = 0.f);
+		virtual void clearBatches(void* layerCache);
+		virtual void breakBatches();
+
+		QuadLayer& quadLayer(void* layerCache);
+		bool batchable(float* transform, BoxFloat& scissor);
+		void emitQuad(const Quad& quad);
+		unsigned int imageTexture(int image);
+
+		void setupBatch();
+		void drawBatch(const QuadBatch& batch, float width, float height, float x, float y);
+
+	protected:
+		unsigned int m_batchProgram;
+		unsigned int m_batchVertexArray;
+		unsigned int m_batchVertexBuffer;
+		int m_batchViewSize;
+		int m_batchOffset;
+
+		std::map<void*, QuadLayer> m_quadLayers;
+		QuadLayer* m_quadLayer;
+	};
+}
+
+#endif // TOY_GLBATCHRENDERER_H
@@ -7,6 +7,7 @@
 #include <toyui/Gl/GlRenderer.h>
 
 #include <toyui/Frame/Layer.h>
+#include <toyui/UiWindow.h>
 
 #ifdef NANOVG_GLEW
 	#include <GL/glew.h>
@@ -22,19 +23,196 @@
 #define NANOVG_GL3_IMPLEMENTATION
 #endif
 
+#include <nanovg.h>
 #include <nanovg_gl.h>
 
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
 namespace toy
 {
+#if NANOVG_GL3
+	static const char* s_shaderHeader =
+		"#version 150 core\n"
+		"#define ATTRIBUTE in\n"
+		"#define VARYING_VS out\n"
+		"#define VARYING_FS in\n"
+		"#define TEXTURE texture\n"
+		"out vec4 outColour;\n";
+#else
+	static const char* s_shaderHeader =
+		"#version 100\n"
+		"precision mediump float;\n"
+		"#define ATTRIBUTE attribute\n"
+		"#define VARYING_VS varying\n"
+		"#define VARYING_FS varying\n"
+		"#define TEXTURE texture2D\n"
+		"#define outColour gl_FragColor\n";
+#endif
+
+	static const char* s_sdfVertexShader =
+		"uniform vec2 u_viewSize;\n"
+		"ATTRIBUTE vec2 a_position;\n"
+		"ATTRIBUTE vec2 a_uv;\n"
+		"ATTRIBUTE vec4 a_colour;\n"
+		"ATTRIBUTE float a_sharpness;\n"
+		"VARYING_VS vec2 v_uv;\n"
+		"VARYING_VS vec4 v_colour;\n"
+		"VARYING_VS float v_sharpness;\n"
+		"void main() {\n"
+		"	v_uv = a_uv;\n"
+		"	v_colour = a_colour;\n"
+		"	v_sharpness = a_sharpness;\n"
+		"	gl_Position = vec4(2.0 * a_position.x / u_viewSize.x - 1.0, 1.0 - 2.0 * a_position.y / u_viewSize.y, 0.0, 1.0);\n"
+		"}\n";
+
+	// the distance field is stored with the glyph edge at 128, alpha ramps over one screen pixel around it
+	static const char* s_sdfFragmentShader =
+		"uniform sampler2D u_atlas;\n"
+		"VARYING_FS vec2 v_uv;\n"
+		"VARYING_FS vec4 v_colour;\n"
+		"VARYING_FS float v_sharpness;\n"
+		"void main() {\n"
+		"	float distance = TEXTURE(u_atlas, v_uv).r;\n"
+		"	float alpha = clamp((distance - 128.0 / 255.0) * v_sharpness + 0.5, 0.0, 1.0) * v_colour.a;\n"
+		"	outColour = vec4(v_colour.rgb * alpha, alpha);\n"
+		"}\n";
+
+	unsigned int GlRenderer::compileShader(unsigned int type, const char* source)
+	{
+		const char* sources[2] = { s_shaderHeader, source };
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 2, sources, nullptr);
+		glCompileShader(shader);
+
+		GLint status;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+		if(status != GL_TRUE)
+		{
+			char log[512];
+			glGetShaderInfoLog(shader, 512, nullptr, log);
+			printf("Could not compile shader : %s\n", log);
+		}
+		return shader;
+	}
+
 	GlRenderer::GlRenderer(const string& resourcePath, bool clear)
 		: NanoRenderer(resourcePath)
 		, m_clear(clear)
 		, m_clock()
+		, m_sdfProgram(0)
+		, m_sdfVertexArray(0)
+		, m_sdfVertexBuffer(0)
+		, m_sdfTexture(0)
+		, m_sdfViewSize(-1)
+		, m_defaultFramebuffer(0)
+		, m_sharedContext(false)
+		, m_sharedImages()
+		, m_ownsSharedImages(false)
+		, m_partialRedraw(false)
+		, m_backbuffer()
+		, m_redrawnArea(0.f)
 	{}
 
 	GlRenderer::~GlRenderer()
 	{}
 
+	static GLuint imageHandle(NVGcontext* ctx, int index)
+	{
+#if NANOVG_GL2
+		return nvglImageHandleGL2(ctx, index);
+#elif NANOVG_GL3
+		return nvglImageHandleGL3(ctx, index);
+#elif NANOVG_GLES2
+		return nvglImageHandleGLES2(ctx, index);
+#endif
+	}
+
+	static int shareImage(NVGcontext* ctx, GLuint texture, const Image& image)
+	{
+		int flags = (image.d_tile ? (NVG_IMAGE_REPEATX | NVG_IMAGE_REPEATY) : 0) | NVG_IMAGE_NODELETE;
+#if NANOVG_GL2
+		return nvglCreateImageFromHandleGL2(ctx, texture, image.d_width, image.d_height, flags);
+#elif NANOVG_GL3
+		return nvglCreateImageFromHandleGL3(ctx, texture, image.d_width, image.d_height, flags);
+#elif NANOVG_GLES2
+		return nvglCreateImageFromHandleGLES2(ctx, texture, image.d_width, image.d_height, flags);
+#endif
+	}
+
+	bool GlRenderer::shareResources(Renderer& source, RenderSystem& system)
+	{
+		// textures can only be shared between contexts created as sharing their objects
+		if(!m_sharedContext || system.fontData().empty())
+			return false;
+
+		GlRenderer& glSource = static_cast<GlRenderer&>(source);
+
+		std::vector<Image*> images;
+		for(Image& image : system.images())
+			images.push_back(&image);
+		images.push_back(&system.imageAtlas().image());
+
+		// the wrappers get the next free indices of this context : they are kept per renderer instead of in the shared images
+		for(Image* image : images)
+		{
+			GLuint texture = imageHandle(glSource.m_ctx, glSource.imageIndex(*image));
+			int index = texture ? shareImage(m_ctx, texture, *image) : 0;
+			if(!index)
+			{
+				printf("GlRenderer : could not share image %s, the window loads its own textures\n", image->d_name.c_str());
+				for(const Image* shared : m_sharedImages)
+				{
+					nvgDeleteImage(m_ctx, m_imageIndices[shared]);
+					m_imageIndices.erase(shared);
+				}
+				m_sharedImages.clear();
+				return false;
+			}
+
+			m_imageIndices[image] = index;
+			m_sharedImages.push_back(image);
+		}
+
+		// the font data is owned by the render system, nanovg must not free it
+		std::vector<unsigned char>& fontData = const_cast<std::vector<unsigned char>&>(system.fontData());
+		nvgCreateFontMem(m_ctx, "dejavu", fontData.data(), int(fontData.size()), 0);
+		nvgFontSize(m_ctx, 14.0f);
+		nvgFontFace(m_ctx, "dejavu");
+
+		return true;
+	}
+
+	bool GlRenderer::adoptResources(Renderer& owner)
+	{
+		UNUSED(owner);
+
+		// only a renderer wrapping the shared textures can take them over, one that loaded its own copies can't
+		if(m_sharedImages.empty())
+			return false;
+
+		m_ownsSharedImages = true;
+		return true;
+	}
+
+	void GlRenderer::unloadImage(Image& image)
+	{
+		auto shared = std::find(m_sharedImages.begin(), m_sharedImages.end(), &image);
+		if(shared != m_sharedImages.end())
+		{
+			// the wrapper doesn't delete the texture it points to : the renderer that took them over deletes it explicitly
+			if(m_ownsSharedImages)
+			{
+				GLuint texture = imageHandle(m_ctx, this->imageIndex(image));
+				glDeleteTextures(1, &texture);
+			}
+			m_sharedImages.erase(shared);
+		}
+
+		NanoRenderer::unloadImage(image);
+	}
+
 	void GlRenderer::setupContext()
 	{
 		this->initGlew();
@@ -56,6 +234,12 @@ namespace toy
 
 	void GlRenderer::releaseContext()
 	{
+		this->releaseSdfText();
+#ifdef TOYUI_DRAW_CACHE
+		this->releaseLayerTargets();
+		this->releaseLayerTarget(m_backbuffer);
+#endif
+
 #if NANOVG_GL2
 		nvgDeleteGL2(m_ctx);
 #elif NANOVG_GL3
@@ -64,6 +248,8 @@ namespace toy
 		nvgDeleteGLES2(m_ctx);
 #endif
 
+		// the shadow atlas image went with the context, the next one uploads it again
+		m_shadowImage = 0;
 		m_ctx = nullptr;
 	}
 
@@ -101,6 +287,299 @@ namespace toy
 			glEnable(GL_FRAMEBUFFER_SRGB);
 	}
 
+	void GlRenderer::setupSdfText()
+	{
+		GLuint vertexShader = compileShader(GL_VERTEX_SHADER, s_sdfVertexShader);
+		GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, s_sdfFragmentShader);
+
+		m_sdfProgram = glCreateProgram();
+		glAttachShader(m_sdfProgram, vertexShader);
+		glAttachShader(m_sdfProgram, fragmentShader);
+		glBindAttribLocation(m_sdfProgram, 0, "a_position");
+		glBindAttribLocation(m_sdfProgram, 1, "a_uv");
+		glBindAttribLocation(m_sdfProgram, 2, "a_colour");
+		glBindAttribLocation(m_sdfProgram, 3, "a_sharpness");
+#if NANOVG_GL3
+		glBindFragDataLocation(m_sdfProgram, 0, "outColour");
+#endif
+		glLinkProgram(m_sdfProgram);
+
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+
+		m_sdfViewSize = glGetUniformLocation(m_sdfProgram, "u_viewSize");
+		glUseProgram(m_sdfProgram);
+		glUniform1i(glGetUniformLocation(m_sdfProgram, "u_atlas"), 0);
+
+#if NANOVG_GL3
+		glGenVertexArrays(1, &m_sdfVertexArray);
+#endif
+		glGenBuffers(1, &m_sdfVertexBuffer);
+		glGenTextures(1, &m_sdfTexture);
+	}
+
+	void GlRenderer::releaseSdfText()
+	{
+		if(!m_sdfProgram)
+			return;
+
+		glDeleteProgram(m_sdfProgram);
+		glDeleteBuffers(1, &m_sdfVertexBuffer);
+		glDeleteTextures(1, &m_sdfTexture);
+#if NANOVG_GL3
+		glDeleteVertexArrays(1, &m_sdfVertexArray);
+#endif
+		m_sdfProgram = 0;
+	}
+
+	void GlRenderer::drawSdfText(const SdfTextBatch& batch, SdfFont& font, float width, float height)
+	{
+		if(!m_sdfProgram)
+		{
+			this->setupSdfText();
+			glBindTexture(GL_TEXTURE_2D, m_sdfTexture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			font.setAtlasDirty();
+		}
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_sdfTexture);
+
+		if(font.atlasDirty())
+		{
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#if NANOVG_GL3
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, font.atlasSize(), font.atlasSize(), 0, GL_RED, GL_UNSIGNED_BYTE, font.atlas());
+#else
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, font.atlasSize(), font.atlasSize(), 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, font.atlas());
+#endif
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			font.clearAtlasDirty();
+		}
+
+		glUseProgram(m_sdfProgram);
+		glUniform2f(m_sdfViewSize, width, height);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_CULL_FACE);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_STENCIL_TEST);
+		glDisable(GL_SCISSOR_TEST);
+
+#if NANOVG_GL3
+		glBindVertexArray(m_sdfVertexArray);
+#endif
+		glBindBuffer(GL_ARRAY_BUFFER, m_sdfVertexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, batch.size() * sizeof(SdfVertex), batch.data(), GL_STREAM_DRAW);
+
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const GLvoid*)offsetof(SdfVertex, x));
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const GLvoid*)offsetof(SdfVertex, u));
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const GLvoid*)offsetof(SdfVertex, r));
+		glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const GLvoid*)offsetof(SdfVertex, sharpness));
+
+		glDrawArrays(GL_TRIANGLES, 0, GLsizei(batch.size()));
+
+		glDisableVertexAttribArray(0);
+		glDisableVertexAttribArray(1);
+		glDisableVertexAttribArray(2);
+		glDisableVertexAttribArray(3);
+#if NANOVG_GL3
+		glBindVertexArray(0);
+#endif
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glUseProgram(0);
+	}
+
+#ifdef TOYUI_DRAW_CACHE
+	static int createImageFromHandle(NVGcontext* ctx, GLuint texture, int width, int height)
+	{
+		// the framebuffer is upside down and holds premultiplied colours, the texture belongs to the layer target
+		int flags = NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED | NVG_IMAGE_NODELETE;
+#if NANOVG_GL2
+		return nvglCreateImageFromHandleGL2(ctx, texture, width, height, flags);
+#elif NANOVG_GL3
+		return nvglCreateImageFromHandleGL3(ctx, texture, width, height, flags);
+#elif NANOVG_GLES2
+		return nvglCreateImageFromHandleGLES2(ctx, texture, width, height, flags);
+#endif
+	}
+
+	bool GlRenderer::bindLayerTarget(LayerTarget& target, int width, int height)
+	{
+		if(target.d_framebuffer && (target.d_width != width || target.d_height != height))
+			this->releaseLayerTarget(target);
+
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_defaultFramebuffer);
+
+		if(target.d_framebuffer)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, target.d_framebuffer);
+			return true;
+		}
+
+		glGenFramebuffers(1, &target.d_framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, target.d_framebuffer);
+
+		glGenTextures(1, &target.d_texture);
+		glBindTexture(GL_TEXTURE_2D, target.d_texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.d_texture, 0);
+
+		// nanovg fills concave paths and strokes through the stencil
+		glGenRenderbuffers(1, &target.d_stencil);
+		glBindRenderbuffer(GL_RENDERBUFFER, target.d_stencil);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_STENCIL_INDEX8, width, height);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.d_stencil);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			printf("Could not create layer target %ix%i.\n", width, height);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_defaultFramebuffer);
+			this->releaseLayerTarget(target);
+			return false;
+		}
+
+		target.d_image = createImageFromHandle(m_ctx, target.d_texture, width, height);
+		target.d_width = width;
+		target.d_height = height;
+		return true;
+	}
+
+	bool GlRenderer::beginLayerTarget(LayerTarget& target, int width, int height)
+	{
+		if(!this->bindLayerTarget(target, width, height))
+			return false;
+
+		glViewport(0, 0, width, height);
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+		return true;
+	}
+
+	void GlRenderer::endLayerTarget(RenderTarget& target)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_defaultFramebuffer);
+		glViewport(0, 0, target.layer().width(), target.layer().height());
+	}
+
+	void GlRenderer::releaseLayerTarget(LayerTarget& target)
+	{
+		if(target.d_image)
+			nvgDeleteImage(m_ctx, target.d_image);
+		if(target.d_texture)
+			glDeleteTextures(1, &target.d_texture);
+		if(target.d_stencil)
+			glDeleteRenderbuffers(1, &target.d_stencil);
+		if(target.d_framebuffer)
+			glDeleteFramebuffers(1, &target.d_framebuffer);
+
+		target = LayerTarget();
+	}
+
+	void GlRenderer::setPartialRedraw(bool enabled)
+	{
+		m_partialRedraw = enabled;
+		if(!enabled)
+			this->releaseLayerTarget(m_backbuffer);
+	}
+
+	void GlRenderer::composite(RenderTarget& target)
+	{
+		if(!m_partialRedraw)
+		{
+			m_redrawnArea = target.layer().width() * target.layer().height();
+			NanoRenderer::composite(target);
+			return;
+		}
+
+		MasterLayer& masterLayer = target.layer();
+		int width = int(masterLayer.width());
+		int height = int(masterLayer.height());
+
+		// nanovg draws in one framebuffer per frame : the main frame is flushed while the backbuffer is updated
+		nvgEndFrame(m_ctx);
+
+		bool resized = m_backbuffer.d_width != width || m_backbuffer.d_height != height;
+		if(!this->bindLayerTarget(m_backbuffer, width, height))
+		{
+			nvgBeginFrame(m_ctx, float(width), float(height), 1.f);
+			NanoRenderer::composite(target);
+			return;
+		}
+
+		// damage rects are snapped to the pixel grid, if they cover most of the target it is cheaper to redraw it in one pass
+		std::vector<BoxFloat> regions;
+		float area = 0.f;
+		bool full = resized || m_backbuffer.d_stale || masterLayer.fullDamage();
+		if(!full)
+			for(const BoxFloat& rect : masterLayer.damage())
+			{
+				float x0 = std::max(std::floor(rect.x()) - 1.f, 0.f);
+				float y0 = std::max(std::floor(rect.y()) - 1.f, 0.f);
+				float x1 = std::min(std::ceil(rect.x() + rect.w()) + 1.f, float(width));
+				float y1 = std::min(std::ceil(rect.y() + rect.h()) + 1.f, float(height));
+				if(x1 <= x0 || y1 <= y0)
+					continue;
+
+				regions.emplace_back(x0, y0, x1 - x0, y1 - y0);
+				area += (x1 - x0) * (y1 - y0);
+			}
+
+		if(full || area > 0.5f * width * height)
+		{
+			regions.clear();
+			regions.emplace_back(0.f, 0.f, float(width), float(height));
+			area = float(width * height);
+		}
+
+		for(const BoxFloat& region : regions)
+		{
+			// the viewport keeps the rasterization inside the region, the scissor keeps the clear inside it
+			GLint x = GLint(region.x());
+			GLint y = GLint(height - region.y() - region.h());
+			GLsizei w = GLsizei(region.w());
+			GLsizei h = GLsizei(region.h());
+
+			glViewport(x, y, w, h);
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(x, y, w, h);
+			glClearColor(0.f, 0.f, 0.f, m_clear ? 1.f : 0.f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+			glDisable(GL_SCISSOR_TEST);
+
+			nvgBeginFrame(m_ctx, region.w(), region.h(), 1.f);
+			this->drawLayers(target, region);
+			nvgEndFrame(m_ctx);
+		}
+
+		m_backbuffer.d_stale = false;
+		m_redrawnArea = area;
+
+		this->endLayerTarget(target);
+
+		// the backbuffer is presented as a single quad
+		nvgBeginFrame(m_ctx, float(width), float(height), 1.f);
+		nvgBeginPath(m_ctx);
+		nvgRect(m_ctx, 0.f, 0.f, float(width), float(height));
+		nvgFillPaint(m_ctx, nvgImagePattern(m_ctx, 0.f, 0.f, float(width), float(height), 0.f, m_backbuffer.d_image, 1.f));
+		nvgFill(m_ctx);
+		this->countDrawCalls(1);
+	}
+#endif
+
 	void GlRenderer::logFPS()
 	{
 		static size_t frames = 0;
@@ -110,7 +589,10 @@ namespace toy
 		double delta = time - prevtime;
 		if(time - prevtime >= 4.f)
 		{
-			printf("fps %f\n", (frames / (time - prevtime)));
+			// the unbatched count is what the same frame costs when every shape and text run is its own nanovg call
+			printf("fps %f, %zu draw calls, %zu unbatched, %zu frames repainted, %zu culled, %zu layers rasterized\n", (frames / (time - prevtime)), m_drawCalls, m_unbatchedCalls, m_drawnFrames, m_culledFrames, m_rasterizedLayers);
+			const Frame::LayoutCounts& layout = Frame::sLayoutCounts;
+			printf("relayout : measured %zu skipped %zu, resized %zu skipped %zu\n", layout.d_measured, layout.d_measureSkipped, layout.d_resized, layout.d_resizeSkipped);
 			prevtime = time;
 			frames = 0;
 		}
@@ -22,16 +22,66 @@ namespace toy
 		virtual void setupContext();
 		virtual void releaseContext();
 
+		void setSharedContext(bool shared) { m_sharedContext = shared; }
+		virtual bool shareResources(Renderer& source, RenderSystem& system);
+		virtual bool adoptResources(Renderer& owner);
+
+		virtual void unloadImage(Image& image);
+
 		void render(RenderTarget& target);
 
+		virtual bool supportsSdfText() { return true; }
+		virtual void drawSdfText(const SdfTextBatch& batch, SdfFont& font, float width, float height);
+
+#ifdef TOYUI_DRAW_CACHE
+		virtual bool supportsLayerTargets() { return true; }
+		virtual bool beginLayerTarget(LayerTarget& target, int width, int height);
+		virtual void endLayerTarget(RenderTarget& target);
+		virtual void releaseLayerTarget(LayerTarget& target);
+
+		// partial redraw : the ui is kept in a persistent backbuffer, only its damaged rects are redrawn
+		bool partialRedraw() { return m_partialRedraw; }
+		void setPartialRedraw(bool enabled);
+
+		float redrawnArea() { return m_redrawnArea; }
+
+		virtual void composite(RenderTarget& target);
+#endif
+
 		void logFPS();
 
 	protected:
 		void initGlew();
 
+		// compiles a shader with the version header of the current gl flavour
+		static unsigned int compileShader(unsigned int type, const char* source);
+
+#ifdef TOYUI_DRAW_CACHE
+		bool bindLayerTarget(LayerTarget& target, int width, int height);
+#endif
+
+		void setupSdfText();
+		void releaseSdfText();
+
 	protected:
 		bool m_clear;
 		Clock m_clock;
+
+		unsigned int m_sdfProgram;
+		unsigned int m_sdfVertexArray;
+		unsigned int m_sdfVertexBuffer;
+		unsigned int m_sdfTexture;
+		int m_sdfViewSize;
+
+		int m_defaultFramebuffer;
+
+		bool m_sharedContext;
+		std::vector<const Image*> m_sharedImages;
+		bool m_ownsSharedImages;
+
+		bool m_partialRedraw;
+		LayerTarget m_backbuffer;
+		float m_redrawnArea;
 	};
 
 
@@ -57,6 +57,21 @@ namespace toy
 		static Type& cls() { static Type ty(INDEXED); return ty; }
 	};
 
+	/* A rectangle of a loaded image, or of the atlas page it was packed in
+	 * Unlike Image it is a plain value : it has no name and is not indexed, so it can be derived and copied freely
+	 */
+	struct Sprite
+	{
+		Sprite() : d_atlas(nullptr), d_index(0), d_left(0), d_top(0), d_width(0), d_height(0) {}
+		Sprite(const Image& image) : d_atlas(image.d_atlas), d_index(image.d_index), d_left(image.d_left), d_top(image.d_top), d_width(image.d_width), d_height(image.d_height) {}
+
+		ImageAtlas* d_atlas;
+		int d_index;
+		int d_left;
+		int d_top;
+		int d_width;
+		int d_height;
+	};
 }
 
 #endif
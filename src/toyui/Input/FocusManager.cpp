@@ -0,0 +1,96 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Input/FocusManager.h>
+
+#include <toyui/Edit/TypeIn.h>
+
+namespace toy
+{
+	FocusManager::FocusManager(InputFrame& rootFrame)
+		: m_rootFrame(rootFrame)
+		, m_chainStamp(InputFrame::s_controlStamp - 1)
+		, m_textInput(nullptr)
+	{}
+
+	const std::vector<InputReceiver*>& FocusManager::focusChain()
+	{
+		if(m_chainStamp != InputFrame::s_controlStamp)
+			this->updateFocusChain();
+
+		return m_focusChain;
+	}
+
+	void FocusManager::updateFocusChain()
+	{
+		m_chainStamp = InputFrame::s_controlStamp;
+		m_focusChain.clear();
+
+		// same walk as InputFrame::dispatchEvent, which doesn't depend on the event itself
+		KeyEvent probe(InputEvent::DEVICE_KEYBOARD, InputEvent::EVENT_PRESSED, KC_UNASSIGNED, 0);
+		InputReceiver* receiver = m_rootFrame.controlEvent(probe);
+
+		while(receiver != &m_rootFrame)
+		{
+			m_focusChain.push_back(receiver);
+			receiver = receiver->propagateEvent(probe);
+		}
+
+		if(m_focusChain.empty() || m_focusChain.front() != static_cast<InputReceiver*>(m_textInput))
+			m_textInput = nullptr;
+	}
+
+	void FocusManager::addShortcut(KeyCode code, int modifiers, const Action& action)
+	{
+		m_shortcuts[shortcutKey(code, modifiers)] = action;
+	}
+
+	void FocusManager::removeShortcut(KeyCode code, int modifiers)
+	{
+		m_shortcuts.erase(shortcutKey(code, modifiers));
+	}
+
+	void FocusManager::dispatchKey(KeyEvent& keyEvent, int modifiers)
+	{
+		const std::vector<InputReceiver*>& chain = this->focusChain();
+
+		if(keyEvent.eventType == InputEvent::EVENT_PRESSED)
+		{
+			// plain keys are left to a focused text input, shortcuts with ctrl always fire
+			auto it = m_shortcuts.find(shortcutKey(keyEvent.code, modifiers));
+			if(it != m_shortcuts.end() && (!m_textInput || (modifiers & KM_CTRL)))
+			{
+				(*it).second();
+				return;
+			}
+
+			// characters typed into the focused text input would stop there anyway
+			if(m_textInput && keyEvent.c != 0 && !(modifiers & KM_CTRL))
+			{
+				chain.front()->receiveEvent(keyEvent);
+				return;
+			}
+		}
+
+		for(InputReceiver* receiver : chain)
+		{
+			receiver->receiveEvent(keyEvent);
+			if(keyEvent.abort)
+				return;
+
+			// control changed while handling the event : finish the walk on the live links
+			if(m_chainStamp != InputFrame::s_controlStamp)
+			{
+				receiver = receiver->propagateEvent(keyEvent);
+				while(receiver != &m_rootFrame && !keyEvent.abort)
+				{
+					receiver->receiveEvent(keyEvent);
+					receiver = receiver->propagateEvent(keyEvent);
+				}
+				return;
+			}
+		}
+	}
+}
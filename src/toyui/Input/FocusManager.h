@@ -0,0 +1,68 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_FOCUSMANAGER_H
+#define TOY_FOCUSMANAGER_H
+
+/* toy */
+#include <toyui/Forward.h>
+#include <toyui/Input/KeyCode.h>
+#include <toyui/Input/InputDispatcher.h>
+
+#include <toyobj/Util/NonCopy.h>
+
+/* std */
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+namespace toy
+{
+	enum KeyModifier
+	{
+		KM_NONE = 0,
+		KM_SHIFT = 1 << 0,
+		KM_CTRL = 1 << 1
+	};
+
+	/* Keyboard events go through the focus chain : the receivers an event would visit walking up from the top controller
+	 * The chain only changes when control is taken or yielded, or when frames are rebound, so it is cached between those
+	 */
+	class TOY_UI_EXPORT FocusManager : public NonCopy
+	{
+	public:
+		typedef std::function<void()> Action;
+
+	public:
+		FocusManager(InputFrame& rootFrame);
+
+		TypeIn* textInput() { return m_textInput; }
+		void setTextInput(TypeIn* typeIn) { m_textInput = typeIn; }
+
+		const std::vector<InputReceiver*>& focusChain();
+
+		void addShortcut(KeyCode code, int modifiers, const Action& action);
+		void removeShortcut(KeyCode code, int modifiers);
+
+		void dispatchKey(KeyEvent& keyEvent, int modifiers);
+
+	protected:
+		static uint32_t shortcutKey(KeyCode code, int modifiers) { return uint32_t(code) | (uint32_t(modifiers) << 16); }
+
+		void updateFocusChain();
+
+	protected:
+		InputFrame& m_rootFrame;
+
+		std::vector<InputReceiver*> m_focusChain;
+		size_t m_chainStamp;
+
+		TypeIn* m_textInput;
+
+		std::unordered_map<uint32_t, Action> m_shortcuts;
+	};
+}
+
+#endif // TOY_FOCUSMANAGER_H
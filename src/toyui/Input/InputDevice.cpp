@@ -8,6 +8,9 @@
 #include <toyui/Widget/RootSheet.h>
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Widget/Cursor.h>
+#include <toyui/Input/InputRecorder.h>
+
+#include <toyui/UiWindow.h>
 
 #include <cassert>
 
@@ -16,12 +19,14 @@ namespace toy
 	InputDevice::InputDevice(RootSheet& rootSheet)
 		: m_rootSheet(rootSheet)
 		, m_rootFrame(rootSheet)
+		, m_recorder(nullptr)
 	{}
 
 	Keyboard::Keyboard(RootSheet& rootSheet)
 		: InputDevice(rootSheet)
 		, m_shiftPressed(false)
 		, m_ctrlPressed(false)
+		, m_focus(rootSheet)
 	{}
 
 	void Keyboard::nextFrame()
@@ -29,6 +34,10 @@ namespace toy
 
 	void Keyboard::dispatchKeyPressed(KeyCode key, char c)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_KEY_PRESSED, 0.f, 0.f, 0.f, uint16_t(key), c);
+
 		/*if(key == KC_ESCAPE)
 			m_shutdownRequested = true;
 		else */if(key == KC_LSHIFT || key == KC_RSHIFT)
@@ -37,18 +46,22 @@ namespace toy
 			m_ctrlPressed = true;
 
 		KeyDownEvent keyEvent(key, c);
-		m_rootFrame.dispatchEvent(keyEvent);
+		m_focus.dispatchKey(keyEvent, this->modifiers());
 	}
 
 	void Keyboard::dispatchKeyReleased(KeyCode key, char c)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_KEY_RELEASED, 0.f, 0.f, 0.f, uint16_t(key), c);
+
 		if(key == KC_LSHIFT || key == KC_RSHIFT)
 			m_shiftPressed = false;
 		else if(key == KC_LCONTROL || key == KC_RCONTROL)
 			m_ctrlPressed = false;
 
 		KeyUpEvent keyEvent(key, c);
-		m_rootFrame.dispatchEvent(keyEvent);
+		m_focus.dispatchKey(keyEvent, this->modifiers());
 	}
 
 	Mouse::Mouse(RootSheet& rootSheet)
@@ -101,6 +114,10 @@ namespace toy
 
 	void Mouse::dispatchMouseMoved(float x, float y)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_MOUSE_MOVED, x, y);
+
 		MouseMoveEvent mouseEvent(x, y);
 		this->transformMouseEvent(mouseEvent);
 
@@ -120,6 +137,10 @@ namespace toy
 
 	void Mouse::dispatchMousePressed(float x, float y, MouseButtonCode button)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_MOUSE_PRESSED, x, y, 0.f, uint16_t(button));
+
 		if(button == LEFT_BUTTON)
 			m_leftButton.mousePressed(x, y);
 		else if(button == RIGHT_BUTTON)
@@ -130,6 +151,10 @@ namespace toy
 
 	void Mouse::dispatchMouseReleased(float x, float y, MouseButtonCode button)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_MOUSE_RELEASED, x, y, 0.f, uint16_t(button));
+
 		if(button == LEFT_BUTTON)
 			m_leftButton.mouseReleased(x, y);
 		else if(button == RIGHT_BUTTON)
@@ -140,6 +165,10 @@ namespace toy
 
 	void Mouse::dispatchMouseWheeled(float x, float y, float amount)
 	{
+		m_rootSheet.uiWindow().scheduler().wake();
+		if(m_recorder)
+			m_recorder->record(RECORD_MOUSE_WHEELED, x, y, amount);
+
 		MouseWheelEvent mouseEvent(x, y, amount);
 		this->transformMouseEvent(mouseEvent);
 
@@ -10,6 +10,7 @@
 #include <toyui/Input/KeyCode.h>
 #include <toyui/Forward.h>
 #include <toyui/Widget/RootSheet.h>
+#include <toyui/Input/FocusManager.h>
 
 #include <vector>
 
@@ -22,9 +23,12 @@ namespace toy
 
 		RootSheet& rootSheet() { return m_rootSheet; }
 
+		void setRecorder(InputRecorder* recorder) { m_recorder = recorder; }
+
 	protected:
 		RootSheet& m_rootSheet;
 		InputFrame& m_rootFrame;
+		InputRecorder* m_recorder;
 	};
 
 	class TOY_UI_EXPORT Keyboard : public InputDevice
@@ -34,6 +38,9 @@ namespace toy
 
 		bool shiftPressed() { return m_shiftPressed; }
 		bool ctrlPressed() { return m_ctrlPressed; }
+		int modifiers() { return (m_shiftPressed ? KM_SHIFT : KM_NONE) | (m_ctrlPressed ? KM_CTRL : KM_NONE); }
+
+		FocusManager& focus() { return m_focus; }
 
 		void nextFrame();
 
@@ -43,6 +50,8 @@ namespace toy
 	protected:
 		bool m_shiftPressed;
 		bool m_ctrlPressed;
+
+		FocusManager m_focus;
 	};
 
 	class TOY_UI_EXPORT MouseButton : public InputDevice
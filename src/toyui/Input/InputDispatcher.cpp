@@ -12,6 +12,8 @@
 
 namespace toy
 {
+	size_t InputFrame::s_controlStamp = 0;
+
 	InputFrame::InputFrame()
 		: m_controller(nullptr)
 		, m_controlled(nullptr)
@@ -93,6 +95,7 @@ namespace toy
 		this->control();
 		m_controlled = &inputFrame;
 		m_controlled->m_controller = this;
+		++s_controlStamp;
 
 		//printf(">>>>> %s TAKE CONTROL OF %s\n", static_cast<Widget&>(*this).style().name(), static_cast<Widget&>(*m_controlled).style().name());
 	}
@@ -110,6 +113,7 @@ namespace toy
 		this->uncontrol();
 		m_controlled->m_controller = nullptr;
 		m_controlled = nullptr;
+		++s_controlStamp;
 
 	}
 
@@ -10,6 +10,8 @@
 #include <toyui/Input/KeyCode.h>
 
 #include <vector>
+#include <thread>
+#include <chrono>
 
 #undef CM_NONE
 
@@ -96,6 +98,11 @@ namespace toy
 	public:
 		virtual bool nextFrame() = 0;
 
+		// block until an input event arrives or the timeout expires, the events are still dispatched in nextFrame
+		virtual void waitEvents(double timeout) { std::this_thread::sleep_for(std::chrono::duration<double>(timeout)); }
+		// interrupts waitEvents, can be called from any thread
+		virtual void wakeEvents() {}
+
 		virtual void initInput(Mouse& mouse, Keyboard& keyboard) = 0;
 		virtual void resize(size_t width, size_t height) = 0;
 	};
@@ -127,7 +134,7 @@ namespace toy
 		~InputFrame();
 
 		InputFrame* parentFrame() { return m_parentFrame; }
-		void setParentFrame(InputFrame* parentFrame) { m_parentFrame = parentFrame; }
+		void setParentFrame(InputFrame* parentFrame) { m_parentFrame = parentFrame; ++s_controlStamp; }
 
 		virtual InputFrame& rootFrame();
 		virtual InputFrame& rootController();
@@ -149,6 +156,9 @@ namespace toy
 		virtual void modal() {};
 		virtual void unmodal() {};
 
+		// incremented whenever the control links or the parent frames change
+		static size_t s_controlStamp;
+
 	protected:
 		InputFrame* m_controller;
 		InputFrame* m_controlled;
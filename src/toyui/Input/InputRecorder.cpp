@@ -0,0 +1,265 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Input/InputRecorder.h>
+
+#include <toyui/Input/InputDevice.h>
+#include <toyui/Widget/RootSheet.h>
+#include <toyui/Frame/Frame.h>
+
+#include <toyui/UiWindow.h>
+
+/* std */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace toy
+{
+	static const char s_inputMagic[4] = { 'T', 'O', 'Y', 'I' };
+	static const uint32_t s_inputVersion = 1;
+
+	struct InputFileHeader
+	{
+		char d_magic[4];
+		uint32_t d_version;
+		uint32_t d_count;
+		float d_width;
+		float d_height;
+	};
+
+	InputRecorder::InputRecorder(RootSheet& rootSheet)
+		: m_rootSheet(rootSheet)
+		, m_recording(false)
+		, m_startFrame(0)
+	{}
+
+	InputRecorder::~InputRecorder()
+	{
+		this->stop();
+	}
+
+	void InputRecorder::start()
+	{
+		m_records.clear();
+		m_recording = true;
+		m_startFrame = m_rootSheet.frameIndex();
+		m_startTime = std::chrono::steady_clock::now();
+
+		m_rootSheet.mouse().setRecorder(this);
+		m_rootSheet.keyboard().setRecorder(this);
+	}
+
+	void InputRecorder::stop()
+	{
+		if(!m_recording)
+			return;
+
+		m_recording = false;
+		m_rootSheet.mouse().setRecorder(nullptr);
+		m_rootSheet.keyboard().setRecorder(nullptr);
+	}
+
+	void InputRecorder::record(InputRecordType type, float x, float y, float z, uint16_t code, char c)
+	{
+		auto elapsed = std::chrono::steady_clock::now() - m_startTime;
+
+		InputRecord record;
+		record.d_frame = uint32_t(m_rootSheet.frameIndex() - m_startFrame);
+		record.d_time = uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+		record.d_type = type;
+		record.d_char = uint8_t(c);
+		record.d_code = code;
+		record.d_x = x;
+		record.d_y = y;
+		record.d_z = z;
+
+		m_records.push_back(record);
+	}
+
+	bool InputRecorder::save(const string& path)
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		if(!file)
+		{
+			printf("Could not open input recording %s for writing\n", path.c_str());
+			return false;
+		}
+
+		InputFileHeader header;
+		memcpy(header.d_magic, s_inputMagic, 4);
+		header.d_version = s_inputVersion;
+		header.d_count = uint32_t(m_records.size());
+		header.d_width = m_rootSheet.frame().width();
+		header.d_height = m_rootSheet.frame().height();
+
+		fwrite(&header, sizeof(InputFileHeader), 1, file);
+		if(!m_records.empty())
+			fwrite(m_records.data(), sizeof(InputRecord), m_records.size(), file);
+
+		fclose(file);
+		return true;
+	}
+
+	InputReplayer::InputReplayer()
+		: m_numFrames(0)
+		, m_cursor(0)
+		, m_width(0.f)
+		, m_height(0.f)
+	{}
+
+	bool InputReplayer::load(const string& path)
+	{
+		FILE* file = fopen(path.c_str(), "rb");
+		if(!file)
+		{
+			printf("Could not open input recording %s\n", path.c_str());
+			return false;
+		}
+
+		InputFileHeader header;
+		if(fread(&header, sizeof(InputFileHeader), 1, file) != 1 || memcmp(header.d_magic, s_inputMagic, 4) != 0 || header.d_version != s_inputVersion)
+		{
+			printf("Invalid input recording %s\n", path.c_str());
+			fclose(file);
+			return false;
+		}
+
+		m_records.resize(header.d_count);
+		size_t count = header.d_count ? fread(m_records.data(), sizeof(InputRecord), header.d_count, file) : 0;
+		fclose(file);
+
+		if(count != header.d_count)
+		{
+			printf("Truncated input recording %s : %zu records out of %u\n", path.c_str(), count, header.d_count);
+			m_records.resize(count);
+		}
+
+		m_width = header.d_width;
+		m_height = header.d_height;
+		m_numFrames = m_records.empty() ? 0 : m_records.back().d_frame + 1;
+		m_cursor = 0;
+
+		// a frame is clocked at the time of its first input, the frames without input are spread evenly in between
+		m_frameTicks.assign(m_numFrames, 0);
+		size_t lastFrame = 0;
+		size_t lastTick = 0;
+		for(const InputRecord& record : m_records)
+		{
+			size_t frame = record.d_frame;
+			size_t tick = std::max(size_t(record.d_time / 1000), lastTick);
+			for(size_t between = lastFrame + 1; between <= frame; ++between)
+				m_frameTicks[between] = lastTick + (tick - lastTick) * (between - lastFrame) / (frame - lastFrame);
+
+			lastFrame = frame;
+			lastTick = tick;
+		}
+
+		return true;
+	}
+
+	void InputReplayer::dispatchFrame(RootSheet& rootSheet, size_t frame)
+	{
+		Mouse& mouse = rootSheet.mouse();
+		Keyboard& keyboard = rootSheet.keyboard();
+
+		for(; m_cursor < m_records.size() && m_records[m_cursor].d_frame <= frame; ++m_cursor)
+		{
+			InputRecord& record = m_records[m_cursor];
+			switch(record.d_type)
+			{
+			case RECORD_MOUSE_MOVED:
+				mouse.dispatchMouseMoved(record.d_x, record.d_y); break;
+			case RECORD_MOUSE_PRESSED:
+				mouse.dispatchMousePressed(record.d_x, record.d_y, MouseButtonCode(record.d_code)); break;
+			case RECORD_MOUSE_RELEASED:
+				mouse.dispatchMouseReleased(record.d_x, record.d_y, MouseButtonCode(record.d_code)); break;
+			case RECORD_MOUSE_WHEELED:
+				mouse.dispatchMouseWheeled(record.d_x, record.d_y, record.d_z); break;
+			case RECORD_KEY_PRESSED:
+				keyboard.dispatchKeyPressed(KeyCode(record.d_code), char(record.d_char)); break;
+			case RECORD_KEY_RELEASED:
+				keyboard.dispatchKeyReleased(KeyCode(record.d_code), char(record.d_char)); break;
+			}
+		}
+	}
+
+	void InputReplayer::replay(UiWindow& window, bool verbose)
+	{
+		if(window.width() != m_width || window.height() != m_height)
+			printf("Replaying input recorded at %.0fx%.0f in a %.0fx%.0f window\n", m_width, m_height, window.width(), window.height());
+
+		m_cursor = 0;
+		m_frameTimes.clear();
+		m_frameTimes.reserve(m_numFrames);
+
+		// frames are replayed as fast as possible, the pacing would hide their actual cost
+		FrameScheduler& scheduler = window.scheduler();
+		float targetRate = scheduler.targetRate();
+		bool vsync = scheduler.vsync();
+		bool adaptive = scheduler.adaptive();
+		scheduler.setTargetRate(0.f);
+		scheduler.setVsync(false);
+		scheduler.setAdaptive(false);
+
+		// the animations and timers see the recorded times, and the live input can't interfere with the recorded one
+		window.beginReplay();
+
+		for(size_t frame = 0; frame < m_numFrames; ++frame)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			window.setReplayTick(m_frameTicks[frame]);
+			this->dispatchFrame(window.rootSheet(), frame);
+			bool pursue = window.nextFrame();
+
+			auto elapsed = std::chrono::steady_clock::now() - start;
+			float ms = std::chrono::duration<float, std::milli>(elapsed).count();
+			m_frameTimes.push_back(ms);
+
+			if(verbose)
+				printf("Replay frame %zu : %.3f ms\n", frame, ms);
+
+			if(!pursue)
+				break;
+		}
+
+		window.endReplay();
+
+		scheduler.setTargetRate(targetRate);
+		scheduler.setVsync(vsync);
+		scheduler.setAdaptive(adaptive);
+
+		if(m_frameTimes.empty())
+			return;
+
+		std::vector<float> sorted = m_frameTimes;
+		std::sort(sorted.begin(), sorted.end());
+
+		float total = 0.f;
+		for(float ms : sorted)
+			total += ms;
+
+		printf("Replayed %zu frames : average %.3f ms, median %.3f ms, 95th percentile %.3f ms, max %.3f ms\n", sorted.size(),
+			   total / sorted.size(), sorted[sorted.size() / 2], sorted[sorted.size() * 95 / 100], sorted.back());
+	}
+
+	bool InputReplayer::saveTimings(const string& path)
+	{
+		FILE* file = fopen(path.c_str(), "w");
+		if(!file)
+		{
+			printf("Could not open replay timings %s for writing\n", path.c_str());
+			return false;
+		}
+
+		fprintf(file, "frame,ms\n");
+		for(size_t frame = 0; frame < m_frameTimes.size(); ++frame)
+			fprintf(file, "%zu,%.3f\n", frame, m_frameTimes[frame]);
+
+		fclose(file);
+		return true;
+	}
+}
@@ -0,0 +1,99 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_INPUTRECORDER_H
+#define TOY_INPUTRECORDER_H
+
+/* toy */
+#include <toyui/Forward.h>
+#include <toyui/Input/KeyCode.h>
+
+#include <toyobj/Util/NonCopy.h>
+
+/* std */
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace toy
+{
+	enum InputRecordType : uint8_t
+	{
+		RECORD_MOUSE_MOVED,
+		RECORD_MOUSE_PRESSED,
+		RECORD_MOUSE_RELEASED,
+		RECORD_MOUSE_WHEELED,
+		RECORD_KEY_PRESSED,
+		RECORD_KEY_RELEASED
+	};
+
+	// Records are written as is, the file is only meant to be replayed on the same architecture
+	struct InputRecord
+	{
+		uint32_t d_frame;		// Frame index, relative to the start of the recording
+		uint32_t d_time;		// Microseconds since the start of the recording
+		uint8_t d_type;
+		uint8_t d_char;
+		uint16_t d_code;		// Key code or mouse button code
+		float d_x;
+		float d_y;
+		float d_z;
+	};
+
+	class TOY_UI_EXPORT InputRecorder : public NonCopy
+	{
+	public:
+		InputRecorder(RootSheet& rootSheet);
+		~InputRecorder();
+
+		bool recording() { return m_recording; }
+		const std::vector<InputRecord>& records() { return m_records; }
+
+		void start();
+		void stop();
+
+		void record(InputRecordType type, float x, float y, float z = 0.f, uint16_t code = 0, char c = 0);
+
+		bool save(const string& path);
+
+	protected:
+		RootSheet& m_rootSheet;
+		bool m_recording;
+		size_t m_startFrame;
+		std::chrono::steady_clock::time_point m_startTime;
+
+		std::vector<InputRecord> m_records;
+	};
+
+	class TOY_UI_EXPORT InputReplayer : public NonCopy
+	{
+	public:
+		InputReplayer();
+
+		size_t numFrames() { return m_numFrames; }
+		const std::vector<float>& frameTimes() { return m_frameTimes; }
+
+		bool load(const string& path);
+
+		void dispatchFrame(RootSheet& rootSheet, size_t frame);
+
+		void replay(UiWindow& window, bool verbose = false);
+
+		bool saveTimings(const string& path);
+
+	protected:
+		std::vector<InputRecord> m_records;
+		size_t m_numFrames;
+		size_t m_cursor;
+
+		float m_width;
+		float m_height;
+
+		// the tick each frame is replayed at, in milliseconds like the window clock
+		std::vector<size_t> m_frameTicks;
+		std::vector<float> m_frameTimes;
+	};
+}
+
+#endif // TOY_INPUTRECORDER_H
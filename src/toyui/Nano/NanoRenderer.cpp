@@ -19,6 +19,8 @@
 #include <nanovg.h>
 
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 
 namespace toy
 {
@@ -42,9 +44,49 @@ namespace toy
 							colour.a());
 	}
 
+	// pieces of rect outside of hole, there are at most four
+	size_t cutRect(const BoxFloat& rect, const BoxFloat& hole, BoxFloat* pieces)
+	{
+		float left = std::max(rect.x(), hole.x());
+		float top = std::max(rect.y(), hole.y());
+		float right = std::min(rect.x() + rect.w(), hole.x() + hole.w());
+		float bottom = std::min(rect.y() + rect.h(), hole.y() + hole.h());
+
+		if(left >= right || top >= bottom)
+		{
+			pieces[0] = rect;
+			return 1;
+		}
+
+		size_t count = 0;
+		if(top > rect.y())
+			pieces[count++] = BoxFloat(rect.x(), rect.y(), rect.w(), top - rect.y());
+		if(bottom < rect.y() + rect.h())
+			pieces[count++] = BoxFloat(rect.x(), bottom, rect.w(), rect.y() + rect.h() - bottom);
+		if(left > rect.x())
+			pieces[count++] = BoxFloat(rect.x(), top, left - rect.x(), bottom - top);
+		if(right < rect.x() + rect.w())
+			pieces[count++] = BoxFloat(right, top, rect.x() + rect.w() - right, bottom - top);
+		return count;
+	}
+
+	bool NanoRenderer::sDebugSdfText = false;
+
 	NanoRenderer::NanoRenderer(const string& resourcePath)
 		: Renderer(resourcePath)
 		, m_ctx(nullptr)
+		, m_imageIndices()
+#ifdef TOYUI_DRAW_CACHE
+		, m_updateCache(nullptr)
+#endif
+		, m_layerTargets()
+		, m_rasterizedLayers(0)
+		, m_shadowCache()
+		, m_shadowImage(0)
+		, m_sdfFont()
+		, m_sdfBatches()
+		, m_sdfRuns()
+		, m_sdfBatch(nullptr)
 	{}
 
 	NanoRenderer::~NanoRenderer()
@@ -64,49 +106,144 @@ namespace toy
 		nvgCreateFont(m_ctx, "dejavu", fontPath.c_str());
 		nvgFontSize(m_ctx, 14.0f);
 		nvgFontFace(m_ctx, "dejavu");
+
+		if(m_sdfFont && sDebugSdfText)
+			this->compareSdfText();
+	}
+
+	void NanoRenderer::enableSdfText(bool enabled)
+	{
+		if(!enabled || !this->supportsSdfText())
+		{
+			m_sdfFont = nullptr;
+			m_sdfBatches.clear();
+			m_sdfRuns.clear();
+			return;
+		}
+
+		m_sdfFont = make_unique<SdfFont>();
+		if(!m_sdfFont->load(m_resourcePath + "interface/fonts/DejaVuSans.ttf"))
+			m_sdfFont = nullptr;
+	}
+
+	void NanoRenderer::compareSdfText()
+	{
+		// the distance field glyphs are placed with the same metrics as nanovg : any difference in the advances shows here
+		const char* text = "The quick brown fox jumps over the lazy dog, 0123456789 ÀÉÎÕÜ";
+		const char* end = text + strlen(text);
+
+		for(float size = 10.f; size <= 24.f; size += 1.f)
+		{
+			nvgFontSize(m_ctx, size);
+			float nanoWidth = nvgTextBounds(m_ctx, 0.f, 0.f, text, end, nullptr);
+			float sdfWidth = m_sdfFont->textWidth(text, end, size);
+			if(std::abs(nanoWidth - sdfWidth) > 0.5f)
+				printf("SDF text : %.0fpx text is %f wide, %f with nanovg\n", size, sdfWidth, nanoWidth);
+		}
+
+		nvgFontSize(m_ctx, 14.0f);
+	}
+
+	void NanoRenderer::countPath()
+	{
+#ifdef TOYUI_DRAW_CACHE
+		if(m_updateCache)
+		{
+			++m_layerPaths[m_updateCache];
+			return;
+		}
+#endif
+		this->countDrawCalls(1);
+	}
+
+	void NanoRenderer::clearBatches(void* layerCache)
+	{
+		if(m_sdfFont)
+		{
+			m_sdfBatches[layerCache].clear();
+			m_sdfRuns[layerCache] = 0;
+		}
+	}
+
+	void NanoRenderer::flushBatches(void* layerCache, float width, float height, float x, float y)
+	{
+		if(!m_sdfFont)
+			return;
+
+		SdfTextBatch& batch = m_sdfBatches[layerCache];
+		if(batch.empty())
+			return;
+
+		// nanovg only draws on end frame : flush it so that the layer text goes on top of the layer shapes
+		nvgEndFrame(m_ctx);
+		if(x == 0.f && y == 0.f)
+		{
+			this->drawSdfText(batch, *m_sdfFont, width, height);
+		}
+		else
+		{
+			SdfTextBatch moved = batch;
+			for(SdfVertex& vertex : moved)
+			{
+				vertex.x += x;
+				vertex.y += y;
+			}
+			this->drawSdfText(moved, *m_sdfFont, width, height);
+		}
+		this->countBatch(1, m_sdfRuns[layerCache]);
+		nvgBeginFrame(m_ctx, width, height, 1.f);
 	}
 
 	void NanoRenderer::loadImageRGBA(Image& image, const unsigned char* data)
 	{
 		image.d_index = nvgCreateImageRGBA(m_ctx, image.d_width, image.d_height, 0, data);
+		m_imageIndices[&image] = image.d_index;
 	}
 
 	void NanoRenderer::loadImage(Image& image)
 	{
 		image.d_index = nvgCreateImage(m_ctx, image.d_path.c_str(), image.d_tile ? (NVG_IMAGE_REPEATX | NVG_IMAGE_REPEATY) : 0);
+		m_imageIndices[&image] = image.d_index;
 	}
 
 	void NanoRenderer::unloadImage(Image& image)
 	{
-		nvgDeleteImage(m_ctx, image.d_index);
+		nvgDeleteImage(m_ctx, this->imageIndex(image));
+		m_imageIndices.erase(&image);
 		image.d_index = 0;
 	}
 
+	int NanoRenderer::imageIndex(const Image& image)
+	{
+		// the resources of the render system are loaded by every window : d_index only holds the last index they were loaded at
+		auto index = m_imageIndices.find(&image);
+		return index != m_imageIndices.end() ? (*index).second : image.d_index;
+	}
+
 	void NanoRenderer::render(RenderTarget& target)
 	{
 		m_debugBatch = 0;
 		Stencil::s_debugBatch = 0;
+		this->resetCounts();
 		static int prevBatch = 0;
 
 		float pixelRatio = 1.f;
-		nvgBeginFrame(m_ctx, target.layer().width(), target.layer().height(), pixelRatio);
+		float width = target.layer().width();
+		float height = target.layer().height();
+		nvgBeginFrame(m_ctx, width, height, pixelRatio);
 
 		if(target.layer().dirty() < Frame::DIRTY_MAPPING)
 		{
 			target.layer().widget()->render(*this, false);
 
 #ifdef TOYUI_DRAW_CACHE
-			void* layerCache = nullptr;
-			this->layerCache(target.layer(), layerCache);
-			this->drawLayer(layerCache, 0.f, 0.f, 1.f);
-
-			for(Layer* layer : target.layer().layers())
-				if(layer->visible())
-				{
-					this->layerCache(*layer, layerCache);
-					this->drawLayer(layerCache, 0.f, 0.f, 1.f);
-				}
+			this->updateLayerTargets(target);
+			this->composite(target);
+#else
+			this->flushBatches(nullptr, width, height);
+			this->clearBatches(nullptr);
 #endif
+			target.layer().clearDamage();
 		}
 
 		if(Stencil::s_debugBatch > 1 && Stencil::s_debugBatch != prevBatch)
@@ -166,7 +303,103 @@ namespace toy
 
 	void NanoRenderer::drawShadow(const BoxFloat& rect, const BoxFloat& corners, const Shadow& shadow)
 	{
-		NVGpaint shadowPaint = nvgBoxGradient(m_ctx, rect.x() + shadow.d_xpos - shadow.d_spread, rect.y() + shadow.d_ypos - shadow.d_spread, rect.w() + shadow.d_spread * 2.f, rect.h() + shadow.d_spread * 2.f, corners.xy() + shadow.d_spread, shadow.d_blur, nvgRGBA(0, 0, 0, 128), nvgRGBA(0, 0, 0, 0));
+		if(!m_shadowCache)
+			m_shadowCache = make_unique<ShadowCache>();
+
+		BoxFloat shape(rect.x() + shadow.d_xpos - shadow.d_spread, rect.y() + shadow.d_ypos - shadow.d_spread, rect.w() + shadow.d_spread * 2.f, rect.h() + shadow.d_spread * 2.f);
+		Colour colour(shadow.d_colour.r(), shadow.d_colour.g(), shadow.d_colour.b(), shadow.d_colour.a() * 0.5f);
+
+		const ShadowSlices* slices = m_shadowCache->slices(corners.xy() + shadow.d_spread, shadow.d_blur, colour);
+
+		// a shape smaller than the curved part of its corners can't be sliced
+		float margin = float(slices ? slices->d_margin : 0);
+		float corner = float(slices ? slices->d_corner : 0);
+		if(!slices || shape.w() + margin * 2.f < corner * 2.f || shape.h() + margin * 2.f < corner * 2.f)
+		{
+			this->drawShadowGradient(rect, corners, shadow);
+			return;
+		}
+
+		this->uploadShadowAtlas();
+
+		float atlasSize = float(m_shadowCache->atlasSize());
+		float size = float(slices->d_size);
+		float strip = float(ShadowCache::s_strip);
+		float left = shape.x() - margin;
+		float top = shape.y() - margin;
+		float right = shape.x() + shape.w() + margin;
+		float bottom = shape.y() + shape.h() + margin;
+
+		float destX[4] = { left, left + corner, right - corner, right };
+		float destY[4] = { top, top + corner, bottom - corner, bottom };
+		float sourceX[4] = { 0.f, corner, corner + strip, size };
+		float sourceY[4] = { 0.f, corner, corner + strip, size };
+
+		// like the gradient, the shadow is cut under the frame so that it doesn't show through a translucent one
+		// the hole is the cross inside the rounded frame, only the squares of the corners are still shadowed
+		float radius = std::min(std::max(std::max(corners.xx(), corners.xy()), std::max(corners.yx(), corners.yy())), std::min(rect.w(), rect.h()) * 0.5f);
+		BoxFloat holeX(rect.x() + radius, rect.y(), rect.w() - radius * 2.f, rect.h());
+		BoxFloat holeY(rect.x(), rect.y() + radius, rect.w(), rect.h() - radius * 2.f);
+
+		for(int row = 0; row < 3; ++row)
+			for(int column = 0; column < 3; ++column)
+			{
+				BoxFloat dest(destX[column], destY[row], destX[column + 1] - destX[column], destY[row + 1] - destY[row]);
+				if(dest.w() <= 0.f || dest.h() <= 0.f)
+					continue;
+
+				// the strip is only sampled in its middle pixels, which all hold the same edge profile
+				float x0 = column == 1 ? sourceX[1] + 1.f : sourceX[column];
+				float x1 = column == 1 ? sourceX[2] - 1.f : sourceX[column + 1];
+				float y0 = row == 1 ? sourceY[1] + 1.f : sourceY[row];
+				float y1 = row == 1 ? sourceY[2] - 1.f : sourceY[row + 1];
+
+				BoxFloat halves[4];
+				BoxFloat pieces[4];
+				size_t numHalves = cutRect(dest, holeX, halves);
+				for(size_t half = 0; half < numHalves; ++half)
+				{
+					size_t numPieces = cutRect(halves[half], holeY, pieces);
+					for(size_t i = 0; i < numPieces; ++i)
+					{
+						const BoxFloat& piece = pieces[i];
+						if(piece.w() <= 0.f || piece.h() <= 0.f)
+							continue;
+
+						// the slice is stretched linearly, so a piece of it samples the same fraction of the source
+						float xscale = (x1 - x0) / dest.w();
+						float yscale = (y1 - y0) / dest.h();
+						BoxFloat source(slices->d_x + x0 + (piece.x() - dest.x()) * xscale, slices->d_y + y0 + (piece.y() - dest.y()) * yscale, piece.w() * xscale, piece.h() * yscale);
+						this->drawImageRegion(m_shadowImage, atlasSize, atlasSize, source, piece);
+					}
+				}
+			}
+	}
+
+	void NanoRenderer::uploadShadowAtlas()
+	{
+		if(!m_shadowImage)
+			m_shadowImage = nvgCreateImageRGBA(m_ctx, m_shadowCache->atlasSize(), m_shadowCache->atlasSize(), 0, m_shadowCache->atlas());
+		else if(m_shadowCache->atlasDirty())
+			nvgUpdateImage(m_ctx, m_shadowImage, m_shadowCache->atlas());
+
+		m_shadowCache->clearAtlasDirty();
+	}
+
+	void NanoRenderer::drawImageRegion(int image, float imageWidth, float imageHeight, const BoxFloat& source, const BoxFloat& dest)
+	{
+		float xscale = dest.w() / source.w();
+		float yscale = dest.h() / source.h();
+		BoxFloat imageRect(dest.x() - source.x() * xscale, dest.y() - source.y() * yscale, imageWidth * xscale, imageHeight * yscale);
+		this->drawImage(image, dest, imageRect);
+	}
+
+	void NanoRenderer::drawShadowGradient(const BoxFloat& rect, const BoxFloat& corners, const Shadow& shadow)
+	{
+		// the same colour as the sliced shadows
+		Colour colour(shadow.d_colour.r(), shadow.d_colour.g(), shadow.d_colour.b(), shadow.d_colour.a() * 0.5f);
+		Colour transparent(shadow.d_colour.r(), shadow.d_colour.g(), shadow.d_colour.b(), 0.f);
+		NVGpaint shadowPaint = nvgBoxGradient(m_ctx, rect.x() + shadow.d_xpos - shadow.d_spread, rect.y() + shadow.d_ypos - shadow.d_spread, rect.w() + shadow.d_spread * 2.f, rect.h() + shadow.d_spread * 2.f, corners.xy() + shadow.d_spread, shadow.d_blur, nvgColour(colour), nvgColour(transparent));
 		nvgBeginPath(m_ctx);
 		nvgRect(m_ctx, rect.x() + shadow.d_xpos - shadow.d_radius, rect.y() + shadow.d_ypos - shadow.d_radius, rect.w() + shadow.d_radius * 2.f, rect.h() + shadow.d_radius * 2.f);
 		if(corners.null())
@@ -175,7 +408,9 @@ namespace toy
 			nvgRoundedRectVarying(m_ctx, rect.x(), rect.y(), rect.w(), rect.h(), corners.xx(), corners.xy(), corners.yx(), corners.yy());
 		nvgPathWinding(m_ctx, NVG_HOLE);
 		nvgFillPaint(m_ctx, shadowPaint);
+		this->breakBatches();
 		nvgFill(m_ctx);
+		this->countPath();
 	}
 
 	void NanoRenderer::drawRect(const BoxFloat& rect, const BoxFloat& corners, InkStyle& skin)
@@ -200,8 +435,8 @@ namespace toy
 		//nvgResetScissor(m_ctx);
 
 		static InkStyle debugStyle;
-		debugStyle.m_borderWidth = 1.f;
-		debugStyle.m_borderColour = colour;
+		debugStyle.setBorderWidth(1.f);
+		debugStyle.setBorderColour(colour);
 
 		this->drawRect(rect, BoxFloat(), debugStyle);
 
@@ -212,7 +447,7 @@ namespace toy
 	{
 		if(skin.linearGradient().null())
 		{
-			nvgFillColor(m_ctx, nvgColour(skin.m_backgroundColour));
+			nvgFillColor(m_ctx, nvgColour(skin.backgroundColour()));
 		}
 		else
 		{
@@ -223,7 +458,9 @@ namespace toy
 			else
 				nvgFillPaint(m_ctx, nvgLinearGradient(m_ctx, rect.x(), rect.y(), rect.x(), rect.y() + rect.h(), first, second));
 		}
+		this->breakBatches();
 		nvgFill(m_ctx);
+		this->countPath();
 	}
 
 	void NanoRenderer::stroke(InkStyle& skin)
@@ -232,7 +469,9 @@ namespace toy
 
 		nvgStrokeWidth(m_ctx, border);
 		nvgStrokeColor(m_ctx, nvgColour(skin.borderColour()));
+		this->breakBatches();
 		nvgStroke(m_ctx);
+		this->countPath();
 	}
 
 	void NanoRenderer::drawImage(int image, const BoxFloat& rect, const BoxFloat& imageRect)
@@ -241,7 +480,9 @@ namespace toy
 		nvgBeginPath(m_ctx);
 		nvgRect(m_ctx, rect.x(), rect.y(), rect.w(), rect.h());
 		nvgFillPaint(m_ctx, imgPaint);
+		this->breakBatches();
 		nvgFill(m_ctx);
+		this->countPath();
 	}
 
 	void NanoRenderer::drawImage(const Image& image, const BoxFloat& rect)
@@ -250,26 +491,32 @@ namespace toy
 		{
 			Image& atlas = image.d_atlas->image();
 			BoxFloat imageRect(rect.x() - image.d_left, rect.y() - image.d_top, float(atlas.d_width), float(atlas.d_height));
-			this->drawImage(atlas.d_index, rect, imageRect);
+			this->drawImage(this->imageIndex(atlas), rect, imageRect);
 		}
 		else
 		{
-			this->drawImage(image.d_index, rect, rect);
+			this->drawImage(this->imageIndex(image), rect, rect);
 		}
 	}
 
 	void NanoRenderer::drawImageStretch(const Image& image, const BoxFloat& rect, float xstretch, float ystretch)
 	{
-		if(image.d_atlas)
+		this->drawSprite(Sprite(image), rect, xstretch, ystretch);
+	}
+
+	void NanoRenderer::drawSprite(const Sprite& sprite, const BoxFloat& rect, float xstretch, float ystretch)
+	{
+		if(sprite.d_atlas)
 		{
-			Image& atlas = image.d_atlas->image();
-			BoxFloat imageRect(rect.x() - image.d_left * xstretch, rect.y() - image.d_top * ystretch, atlas.d_width * xstretch, atlas.d_height * ystretch);
-			this->drawImage(atlas.d_index, rect, imageRect);
+			Image& atlas = sprite.d_atlas->image();
+			BoxFloat imageRect(rect.x() - sprite.d_left * xstretch, rect.y() - sprite.d_top * ystretch, atlas.d_width * xstretch, atlas.d_height * ystretch);
+			this->drawImage(this->imageIndex(atlas), rect, imageRect);
 		}
 		else
 		{
-			BoxFloat imageRect(rect.x(), rect.y(), image.d_width * xstretch, image.d_height * ystretch);
-			this->drawImage(image.d_index, rect, imageRect);
+			// the resources of the render system are all in the atlas, a sprite out of it comes from an image of this window
+			BoxFloat imageRect(rect.x(), rect.y(), sprite.d_width * xstretch, sprite.d_height * ystretch);
+			this->drawImage(sprite.d_index, rect, imageRect);
 		}
 	}
 
@@ -285,113 +532,47 @@ namespace toy
 		nvgFontSize(m_ctx, skin.textSize());
 		nvgFontFace(m_ctx, skin.textFont().c_str());
 		nvgTextAlign(m_ctx, alignH | NVG_ALIGN_TOP);
-
-		m_lineHeight = 0.f;
-		nvgTextMetrics(m_ctx, nullptr, nullptr, &m_lineHeight);
 	}
 
-	void NanoRenderer::fillText(const string& text, const BoxFloat& rect, InkStyle& skin, TextRow& row)
-	{
-		this->setupText(skin);
-
-		row.start = text.c_str();
-		row.end = text.c_str() + text.size();
-		row.rect.assign(rect.x(), rect.y(), this->textSize(text, DIM_X, skin), m_lineHeight);
-
-		this->breakTextLine(rect, row);
-	}
-
-
-	void NanoRenderer::breakTextWidth(const char* first, const char* end, const BoxFloat& rect, InkStyle& skin, TextRow& row)
-	{
-		UNUSED(skin);
-
-		NVGtextRow nvgTextRow;
-		nvgTextBreakLines(m_ctx, first, end, rect.w(), &nvgTextRow, 1);
-
-		row.start = nvgTextRow.start;
-		row.end = nvgTextRow.end;
-		row.rect.assign(rect.x(), rect.y(), nvgTextRow.width, m_lineHeight);
-
-		if(row.start != row.end)
-			this->breakTextLine(rect, row);
-	}
-
-	void NanoRenderer::breakTextReturns(const char* first, const char* end, const BoxFloat& rect, InkStyle& skin, TextRow& row)
-	{
-		const char* iter = first;
-		
-		do
-			++iter;
-		while(*iter != '\n' && iter < end);
-
-		row.start = first;
-		row.end = iter;
-		row.rect.assign(rect.x(), rect.y(), this->textSize(string(first, iter - first), DIM_X, skin), m_lineHeight);
-
-		this->breakTextLine(rect, row);
-	}
-
-	void NanoRenderer::breakText(const string& text, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& textRows)
+	void NanoRenderer::drawText(float x, float y, const char* start, const char* end, InkStyle& skin)
 	{
 		this->setupText(skin);
 
-		const char* first = text.c_str();
-		const char* end = first + text.size();
-
-		textRows.clear();
-	
-		if(!skin.textBreak())
+		if(m_sdfFont)
 		{
-			textRows.resize(1);
-
-			BoxFloat rect(0.f, 0.f, space.x(), m_lineHeight);
-			this->fillText(text, rect, skin, textRows[0]);
+			SdfTextBatch& batch = m_sdfBatch ? *m_sdfBatch : m_sdfBatches[nullptr];
+
+			// same horizontal anchoring as nanovg text alignment
+			if(skin.align()[DIM_X] == CENTER)
+				x -= m_sdfFont->textWidth(start, end, skin.textSize()) / 2.f;
+			else if(skin.align()[DIM_X] == RIGHT)
+				x -= m_sdfFont->textWidth(start, end, skin.textSize());
+
+			float transform[6];
+			BoxFloat scissor;
+			nvgCurrentTransform(m_ctx, transform);
+			nvgCurrentScissor(m_ctx, scissor.pointer());
+
+			// the glyph batch is drawn outside of nanovg, which applies the alpha to everything else
+			const Colour& colour = skin.textColour();
+			m_sdfFont->emitText(batch, x, y, start, end, skin.textSize(), Colour(colour.r(), colour.g(), colour.b(), colour.a() * this->alpha()), transform, scissor);
+#ifdef TOYUI_DRAW_CACHE
+			++m_sdfRuns[m_updateCache];
+#else
+			++m_sdfRuns[nullptr];
+#endif
 			return;
 		}
 
-		while(first < end)
-		{
-			size_t index = textRows.size();
-			textRows.resize(index + 1);
-			TextRow& row = textRows.back();
-
-			BoxFloat rect(0.f, index * m_lineHeight, space.x(), 0.f);
-			if(skin.textWrap())
-				this->breakTextWidth(first, end, rect, skin, row);
-			else
-				this->breakTextReturns(first, end, rect, skin, row);
-
-			row.startIndex = row.start - text.c_str();
-			row.endIndex = row.end - text.c_str();
-			first = row.end + 1;
-		}
-	}
-
-	void NanoRenderer::breakTextLine(const BoxFloat& rect, TextRow& textRow)
-	{
-		size_t numGlyphs = textRow.end - textRow.start;
-		std::vector<NVGglyphPosition> positions;
-		positions.resize(numGlyphs);
-		textRow.glyphs.resize(numGlyphs);
-
-		nvgTextGlyphPositions(m_ctx, rect.x(), rect.y(), textRow.start, textRow.end, &positions.front(), positions.size());
-
-		for(size_t i = 0; i < positions.size(); ++i)
-		{
-			NVGglyphPosition& glyph = positions[i];
-			TextGlyph& out = textRow.glyphs[i];
-			out.position = textRow.start + i;
-			out.rect.assign(glyph.minx, textRow.rect.y(), glyph.maxx - glyph.minx, textRow.rect.h());
-		}
+		nvgFillColor(m_ctx, nvgColour(skin.textColour()));
+		this->breakBatches();
+		nvgText(m_ctx, x, y, start, end);
+		this->countPath();
 	}
 
-	void NanoRenderer::drawText(float x, float y, const char* start, const char* end, InkStyle& skin)
+	void NanoRenderer::applyAlpha(float alpha)
 	{
-		this->setupText(skin);
-
-		nvgFillColor(m_ctx, nvgColour(skin.m_textColour));
-		nvgText(m_ctx, x, y, start, end);
+		nvgGlobalAlpha(m_ctx, alpha);
 	}
 
 	void NanoRenderer::beginTarget()
@@ -422,17 +603,28 @@ namespace toy
 		nvgScale(m_ctx, scale, scale);
 		nvgDrawDisplayList(m_ctx, (NVGdisplayList*)layerCache);
 		nvgRestore(m_ctx);
+
+		this->countDrawCalls(m_layerPaths[layerCache]);
 	}
 
 	void NanoRenderer::clearLayer(void* layerCache)
 	{
 		nvgResetDisplayList((NVGdisplayList*)layerCache);
+
+		auto target = m_layerTargets.find(layerCache);
+		if(target != m_layerTargets.end())
+			(*target).second.d_stale = true;
+
+		m_layerPaths[layerCache] = 0;
+		this->clearBatches(layerCache);
 		//nvgResetScissor(m_ctx);
 	}
 
 	void NanoRenderer::beginUpdate(void* layerCache, float x, float y, float scale)
 	{
 		nvgBindDisplayList(m_ctx, (NVGdisplayList*)layerCache);
+		m_sdfBatch = m_sdfFont ? &m_sdfBatches[layerCache] : nullptr;
+		m_updateCache = layerCache;
 		nvgSave(m_ctx);
 		nvgTranslate(m_ctx, x, y);
 		nvgScale(m_ctx, scale, scale);
@@ -444,34 +636,162 @@ namespace toy
 	{
 		nvgRestore(m_ctx);
 		nvgBindDisplayList(m_ctx, nullptr);
+		m_sdfBatch = nullptr;
+		m_updateCache = nullptr;
 	}
 
-#else
-	void NanoRenderer::beginUpdate(float x, float y)
+	void NanoRenderer::updateLayerTargets(RenderTarget& target)
 	{
-		nvgSave(m_ctx);
-		nvgTranslate(m_ctx, x, y);
+		m_rasterizedLayers = 0;
+		if(!this->supportsLayerTargets())
+			return;
+
+		std::vector<Layer*> stale;
+		std::vector<void*> offscreen;
+		for(Layer* layer : target.layer().layers())
+			if(layer->offscreen())
+			{
+				void* layerCache = nullptr;
+				this->layerCache(*layer, layerCache);
+				offscreen.push_back(layerCache);
+
+				if(!layer->visible())
+					continue;
+
+				LayerTarget& layerTarget = m_layerTargets[layerCache];
+				int width = int(ceil(layer->width() * layer->scale()));
+				int height = int(ceil(layer->height() * layer->scale()));
+
+				if(width > 0 && height > 0 && (layerTarget.d_stale || layerTarget.d_width != width || layerTarget.d_height != height))
+					stale.push_back(layer);
+			}
+
+		// the targets of the layers destroyed or moved back onscreen are released
+		for(auto it = m_layerTargets.begin(); it != m_layerTargets.end();)
+			if(std::find(offscreen.begin(), offscreen.end(), (*it).first) == offscreen.end())
+			{
+				this->releaseLayerTarget((*it).second);
+				it = m_layerTargets.erase(it);
+			}
+			else
+				++it;
+
+		if(stale.empty())
+			return;
+
+		// nanovg draws in one framebuffer per frame : the main frame is flushed while the targets are rasterized
+		nvgEndFrame(m_ctx);
+
+		for(Layer* layer : stale)
+		{
+			void* layerCache = nullptr;
+			this->layerCache(*layer, layerCache);
+
+			LayerTarget& layerTarget = m_layerTargets[layerCache];
+			int width = int(ceil(layer->width() * layer->scale()));
+			int height = int(ceil(layer->height() * layer->scale()));
+
+			if(!this->beginLayerTarget(layerTarget, width, height))
+				continue;
+
+			nvgBeginFrame(m_ctx, float(width), float(height), 1.f);
+			this->drawLayer(layerCache, 0.f, 0.f, 1.f);
+			this->flushBatches(layerCache, float(width), float(height));
+			nvgEndFrame(m_ctx);
+
+			this->endLayerTarget(target);
+			layerTarget.d_stale = false;
+			++m_rasterizedLayers;
+		}
+
+		nvgBeginFrame(m_ctx, target.layer().width(), target.layer().height(), 1.f);
 	}
 
-	void NanoRenderer::endUpdate()
+	void NanoRenderer::composite(RenderTarget& target)
 	{
-		nvgRestore(m_ctx);
+		this->drawLayers(target, BoxFloat(0.f, 0.f, target.layer().width(), target.layer().height()));
 	}
-#endif
 
-	float NanoRenderer::textLineHeight(InkStyle& skin)
+	void NanoRenderer::drawLayers(RenderTarget& target, const BoxFloat& region)
 	{
-		this->setupText(skin);
-		return m_lineHeight;
+		// the region is drawn in a frame of its own size : everything is shifted to its origin
+		float x = -region.x();
+		float y = -region.y();
+
+		void* layerCache = nullptr;
+		this->layerCache(target.layer(), layerCache);
+		this->drawLayer(layerCache, x, y, 1.f);
+		this->flushBatches(layerCache, region.w(), region.h(), x, y);
+
+		for(Layer* layer : target.layer().layers())
+			if(layer->visible())
+			{
+				this->layerCache(*layer, layerCache);
+
+				if(layer->offscreen() && this->supportsLayerTargets())
+				{
+					this->drawLayerTarget(*layer, m_layerTargets[layerCache], x, y);
+					continue;
+				}
+
+				DimFloat origin = this->layerOrigin(*layer);
+				this->drawLayer(layerCache, origin.x() + x, origin.y() + y, 1.f);
+				this->flushBatches(layerCache, region.w(), region.h(), origin.x() + x, origin.y() + y);
+			}
 	}
 
-	float NanoRenderer::textSize(const string& text, Dimension dim, InkStyle& skin)
+	void NanoRenderer::drawLayerTarget(Layer& layer, LayerTarget& layerTarget, float offsetX, float offsetY)
 	{
-		this->setupText(skin);
+		if(!layerTarget.d_image)
+			return;
+
+		DimFloat position = layer.absolutePosition();
+		float x = floor(position.x()) + offsetX;
+		float y = floor(position.y()) + offsetY;
+		float width = float(layerTarget.d_width);
+		float height = float(layerTarget.d_height);
 
-		float bounds[4];
-		nvgTextBounds(m_ctx, 0.f, 0.f, text.c_str(), nullptr, bounds);
+		nvgBeginPath(m_ctx);
+		nvgRect(m_ctx, x, y, width, height);
+		nvgFillPaint(m_ctx, nvgImagePattern(m_ctx, x, y, width, height, 0.f, layerTarget.d_image, 1.f));
+		nvgFill(m_ctx);
+		this->countDrawCalls(1);
+	}
+
+	void NanoRenderer::releaseLayerTargets()
+	{
+		for(auto& kv : m_layerTargets)
+			this->releaseLayerTarget(kv.second);
+
+		m_layerTargets.clear();
+	}
+
+	DimFloat NanoRenderer::layerOrigin(Layer& layer)
+	{
+		if(!this->supportsLayerTargets())
+			return DimFloat(0.f, 0.f);
 
-		return dim == DIM_X ? bounds[2] - bounds[0] : m_lineHeight;
+		// layers inside an offscreen layer are recorded relative to it
+		for(Layer* parent = layer.parentLayer(); parent; parent = parent->parentLayer())
+			if(parent->offscreen())
+			{
+				DimFloat position = parent->absolutePosition();
+				return DimFloat(floor(position.x()), floor(position.y()));
+			}
+
+		return DimFloat(0.f, 0.f);
 	}
+
+#else
+	void NanoRenderer::beginUpdate(float x, float y)
+	{
+		nvgSave(m_ctx);
+		nvgTranslate(m_ctx, x, y);
+	}
+
+	void NanoRenderer::endUpdate()
+	{
+		nvgRestore(m_ctx);
+	}
+#endif
 }
@@ -8,9 +8,25 @@
 /* toy */
 #include <toyui/Forward.h>
 #include <toyui/Render/Renderer.h>
+#include <toyui/Render/SdfFont.h>
+#include <toyui/Render/ShadowCache.h>
 
 namespace toy
 {
+	// Backend handles of the texture an offscreen layer is rasterized in
+	struct LayerTarget
+	{
+		LayerTarget() : d_framebuffer(0), d_texture(0), d_stencil(0), d_image(0), d_width(0), d_height(0), d_stale(true) {}
+
+		unsigned int d_framebuffer;
+		unsigned int d_texture;
+		unsigned int d_stencil;
+		int d_image;
+		int d_width;
+		int d_height;
+		bool d_stale;
+	};
+
 	class TOY_UI_EXPORT NanoRenderer : public Renderer
 	{
 	public:
@@ -26,6 +42,9 @@ namespace toy
 		virtual void loadImage(Image& image);
 		virtual void unloadImage(Image& image);
 
+		// the index of an image in this renderer, which differs from the index it was loaded with when shared
+		int imageIndex(const Image& image);
+
 		// rendering
 		virtual void render(RenderTarget& target);
 
@@ -59,6 +78,7 @@ namespace toy
 		virtual void drawRect(const BoxFloat& rect, const BoxFloat& corners, InkStyle& skin);
 		virtual void drawImage(const Image& image, const BoxFloat& rect);
 		virtual void drawImageStretch(const Image& image, const BoxFloat& rect, float xstretch = 1.f, float ystretch = 1.f);
+		virtual void drawSprite(const Sprite& sprite, const BoxFloat& rect, float xstretch = 1.f, float ystretch = 1.f);
 		virtual void drawText(float x, float y, const char* start, const char* end, InkStyle& skin);
 
 		virtual void debugRect(const BoxFloat& rect, const Colour& colour);
@@ -66,16 +86,57 @@ namespace toy
 		virtual void fill(InkStyle& skin, const BoxFloat& rect);
 		virtual void stroke(InkStyle& skin);
 
-		virtual void fillText(const string& text, const BoxFloat& rect, InkStyle& skin, TextRow& row);
+		// distance field text
+		SdfFont* sdfFont() { return m_sdfFont.get(); }
+		void enableSdfText(bool enabled);
+
+		// diagnostic : report on font load the text widths where the distance field font and nanovg disagree by more than half a pixel
+		static bool sDebugSdfText;
+
+		virtual bool supportsSdfText() { return false; }
+		virtual void drawSdfText(const SdfTextBatch& batch, SdfFont& font, float width, float height) { UNUSED(batch); UNUSED(font); UNUSED(width); UNUSED(height); }
+
+#ifdef TOYUI_DRAW_CACHE
+		// offscreen layers
+		virtual bool beginLayerTarget(LayerTarget& target, int width, int height) { UNUSED(target); UNUSED(width); UNUSED(height); return false; }
+		virtual void endLayerTarget(RenderTarget& target) { UNUSED(target); }
+		virtual void releaseLayerTarget(LayerTarget& target) { UNUSED(target); }
+
+		size_t rasterizedLayers() { return m_rasterizedLayers; }
+#endif
+
+	protected:
+		// the batches recorded beside the nanovg paths of a layer, the distance field text goes on top of everything
+		virtual void flushBatches(void* layerCache, float width, float height, float x = 0.f, float y = 0.f);
+		virtual void clearBatches(void* layerCache);
+
+		// one nanovg fill or stroke, counted when the layer holding it is drawn
+		void countPath();
+
+		// a nanovg path is about to be recorded : batches drawn beside nanovg are closed there, to keep the paint order
+		virtual void breakBatches() {}
+
+		void compareSdfText();
+
+		virtual void applyAlpha(float alpha);
+
+		// draws the source rect of an image stretched over the destination rect
+		virtual void drawImageRegion(int image, float imageWidth, float imageHeight, const BoxFloat& source, const BoxFloat& dest);
+
+		void drawShadowGradient(const BoxFloat& rect, const BoxFloat& corners, const Shadow& shadow);
+		void uploadShadowAtlas();
 
-		virtual void breakText(const string& text, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& textRows);
-		virtual void breakTextLine(const BoxFloat& rect, TextRow& textRow);
+#ifdef TOYUI_DRAW_CACHE
+		void updateLayerTargets(RenderTarget& target);
+		void drawLayerTarget(Layer& layer, LayerTarget& layerTarget, float offsetX = 0.f, float offsetY = 0.f);
 
-		virtual void breakTextWidth(const char* string, const char* end, const BoxFloat& rect, InkStyle& skin, TextRow& textRow);
-		virtual void breakTextReturns(const char* string, const char* end, const BoxFloat& rect, InkStyle& skin, TextRow& textRow);
+		// draw the layers in a frame covering a region of the target, composite draws the whole target by default
+		virtual void composite(RenderTarget& target);
+		void drawLayers(RenderTarget& target, const BoxFloat& region);
+		void releaseLayerTargets();
 
-		virtual float textLineHeight(InkStyle& skin);
-		virtual float textSize(const string& text, Dimension dim, InkStyle& skin);
+		DimFloat layerOrigin(Layer& layer);
+#endif
 
 	private:
 		void setupText(InkStyle& skin);
@@ -85,9 +146,23 @@ namespace toy
 	protected:
 		NVGcontext* m_ctx;
 
-		float m_lineHeight;
+		std::map<const Image*, int> m_imageIndices;
 
 		std::map<Layer*, NVGdisplayList*> m_layers;
+#ifdef TOYUI_DRAW_CACHE
+		std::map<void*, size_t> m_layerPaths;
+		void* m_updateCache;
+#endif
+		std::map<void*, LayerTarget> m_layerTargets;
+		size_t m_rasterizedLayers;
+
+		unique_ptr<ShadowCache> m_shadowCache;
+		int m_shadowImage;
+
+		unique_ptr<SdfFont> m_sdfFont;
+		std::map<void*, SdfTextBatch> m_sdfBatches;
+		std::map<void*, size_t> m_sdfRuns;
+		SdfTextBatch* m_sdfBatch;
 	};
 }
 
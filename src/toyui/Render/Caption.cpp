@@ -4,6 +4,7 @@
 
 #include <toyui/Config.h>
 #include <toyui/Render/Caption.h>
+#include <toyui/Render/FontMetrics.h>
 
 #include <toyui/Widget/Widget.h>
 #include <toyui/Frame/Frame.h>
@@ -12,6 +13,10 @@
 #include <toyui/UiWindow.h>
 #include <toyui/Widget/RootSheet.h>
 
+/* std */
+#include <algorithm>
+#include <iterator>
+
 using namespace std::placeholders;
 
 namespace toy
@@ -21,28 +26,28 @@ namespace toy
 		, m_caret(-1)
 		, m_selectStart(-1)
 		, m_selectEnd(-1)
+		, m_textWidth(0.f)
+		, m_breakWidth(0.f)
 	{}
 
 	float Caption::textSize(Dimension dim)
 	{
-		float result = 0.f;
+		if(m_textRows.empty())
+			return 0.f;
 
 		if(dim == DIM_X)
-			for(TextRow& row : m_textRows)
-				result = std::max(result, row.rect.w());
-		else if(dim == DIM_Y)
-			result = m_textRows.back().rect.y() + m_textRows.back().rect.h();
-
-		return result;
+			return m_textWidth;
+		else
+			return m_textRows.back().rect.y() + m_textRows.back().rect.h();
 	}
 
 	void Caption::redraw(Renderer& target, const BoxFloat& rect, const BoxFloat& paddedRect, const BoxFloat& contentRect)
 	{
 		static InkStyle textSelectionStyle;
-		textSelectionStyle.m_backgroundColour = Colour(0/255.f, 55/255.f, 255/255.f, 124/255.f);
+		textSelectionStyle.setBackgroundColour(Colour(0/255.f, 55/255.f, 255/255.f, 124/255.f));
 
 		static InkStyle caretStyle;
-		caretStyle.m_backgroundColour = Colour::White;
+		caretStyle.setBackgroundColour(Colour::White);
 
 		if(paddedRect.w() <= 0.f || paddedRect.h() <= 0.f)
 			return;
@@ -55,58 +60,188 @@ namespace toy
 		if(m_frame.image())
 			target.drawImage(*m_frame.image(), contentRect);
 
-		if(!m_frame.text().empty())
-			for(TextRow& row : m_textRows)
-			{
-				if(!row.selected.null())
-					target.drawRect(BoxFloat(paddedRect.x() + row.selected.x(), paddedRect.y() + row.selected.y(), row.selected.w(), row.selected.h()), BoxFloat(), textSelectionStyle);
+		if(m_frame.text().empty() || m_textRows.empty())
+			return;
+
+		// only the rows inside the visible rect of the clipping ancestors are drawn
+		size_t first = 0;
+		size_t last = m_textRows.size();
+
+		if(target.bounded())
+		{
+			Frame& frame = m_frame.frame();
+			float top = (target.viewport().y() - frame.dposition(DIM_Y)) / frame.scale() - paddedRect.y();
+			float bottom = top + target.viewport().h() / frame.scale();
+			first = this->rowAt(top);
+			last = std::min(this->rowAt(bottom) + 1, m_textRows.size());
+		}
 
+		for(size_t i = first; i < last; ++i)
+		{
+			TextRow& row = m_textRows[i];
+
+			if(!row.selected.null())
+				target.drawRect(BoxFloat(paddedRect.x() + row.selected.x(), paddedRect.y() + row.selected.y(), row.selected.w(), row.selected.h()), BoxFloat(), textSelectionStyle);
+
+			if(row.start != row.end)
 				target.drawText(paddedRect.x() + row.rect.x(), paddedRect.y() + row.rect.y(), row.start, row.end, m_frame.inkstyle());
 
-				if(!row.caret.null())
-					target.drawRect(BoxFloat(paddedRect.x() + row.caret.x(), paddedRect.y() + row.caret.y(), row.caret.w(), row.caret.h()), BoxFloat(), caretStyle);
-			}
+			if(!row.caret.null())
+				target.drawRect(BoxFloat(paddedRect.x() + row.caret.x(), paddedRect.y() + row.caret.y(), row.caret.w(), row.caret.h()), BoxFloat(), caretStyle);
+		}
 	}
 
-	void Caption::updateTextRows(Renderer& target, const DimFloat& space)
+	void Caption::updateTextRows(const FontMetrics& metrics, const DimFloat& space)
 	{
-		std::vector<TextRow> textRows = m_textRows;
+		m_breakWidth = space.x();
+		m_markedRows.clear();
 
 		if(!m_frame.text().empty())
-			target.breakText(m_frame.text(), space, m_frame.inkstyle(), m_textRows);
+			metrics.breakText(m_frame.text(), space, m_frame.inkstyle(), m_textRows);
 		else
 			m_textRows.clear();
 
+		this->updateTextWidth();
 		this->updateSelection();
 	}
 
-	void Caption::updateSelection()
+	void Caption::editTextRows(const FontMetrics& metrics, const DimFloat& space, size_t position, size_t erased, size_t inserted)
 	{
-		if(m_textRows.empty())
-			return;
+		const string& text = m_frame.text();
 
-		const char* start = m_textRows[0].start;
+		if(m_textRows.empty() || text.empty() || !m_frame.inkstyle().textBreak() || space.x() != m_breakWidth)
+			return this->updateTextRows(metrics, space);
 
-		for(TextRow& row : m_textRows)
+		// only the paragraphs touched by the edit are broken again, the rows that follow are just moved
+		size_t first = position == 0 ? string::npos : text.rfind('\n', position - 1);
+		first = first == string::npos ? 0 : first + 1;
+
+		size_t last = text.find('\n', position + inserted);
+		last = last == string::npos ? text.size() : last;
+
+		ptrdiff_t delta = ptrdiff_t(inserted) - ptrdiff_t(erased);
+		size_t previousLast = size_t(ptrdiff_t(last) - delta);
+
+		auto byStart = [](const TextRow& row, size_t index) { return row.startIndex < index; };
+		auto byStartUpper = [](size_t index, const TextRow& row) { return index < row.startIndex; };
+
+		size_t firstRow = std::lower_bound(m_textRows.begin(), m_textRows.end(), first, byStart) - m_textRows.begin();
+		size_t endRow = std::upper_bound(m_textRows.begin(), m_textRows.end(), previousLast, byStartUpper) - m_textRows.begin();
+
+		if(firstRow >= endRow)
+			return this->updateTextRows(metrics, space);
+
+		this->clearSelection();
+
+		std::vector<TextRow> rows;
+		metrics.breakTextRange(text, first, last, space, m_frame.inkstyle(), rows);
+
+		float top = m_textRows[firstRow].rect.y();
+		float previousBottom = m_textRows[endRow - 1].rect.y() + m_textRows[endRow - 1].rect.h();
+		float bottom = top + rows.back().rect.y() + rows.back().rect.h();
+
+		float removedWidth = 0.f;
+		for(size_t i = firstRow; i < endRow; ++i)
+			removedWidth = std::max(removedWidth, m_textRows[i].rect.w());
+
+		float insertedWidth = 0.f;
+		for(TextRow& row : rows)
 		{
-			row.selected.clear();
-			row.caret.clear();
+			row.rect.assign(row.rect.x(), top + row.rect.y(), row.rect.w(), row.rect.h());
+			insertedWidth = std::max(insertedWidth, row.rect.w());
+		}
+
+		// the text may have been reallocated : rows keep their indices, their pointers are rebased
+		const char* begin = text.c_str();
+		const char* previousBegin = m_textRows.front().start - m_textRows.front().startIndex;
+
+		m_textRows.erase(m_textRows.begin() + firstRow, m_textRows.begin() + endRow);
+		m_textRows.insert(m_textRows.begin() + firstRow, std::make_move_iterator(rows.begin()), std::make_move_iterator(rows.end()));
+
+		// the rows before the edit only move with the text, the new rows already point into it
+		if(begin != previousBegin)
+			for(size_t i = 0; i < firstRow; ++i)
+			{
+				m_textRows[i].start = begin + m_textRows[i].startIndex;
+				m_textRows[i].end = begin + m_textRows[i].endIndex;
+			}
+
+		for(size_t i = firstRow + rows.size(); i < m_textRows.size(); ++i)
+		{
+			TextRow& row = m_textRows[i];
+			row.startIndex += delta;
+			row.endIndex += delta;
+			row.start = begin + row.startIndex;
+			row.end = begin + row.endIndex;
+			row.rect.assign(row.rect.x(), row.rect.y() + bottom - previousBottom, row.rect.w(), row.rect.h());
+		}
+
+		// the widest row is only searched again when it was edited and got narrower
+		if(insertedWidth >= m_textWidth || removedWidth < m_textWidth)
+			m_textWidth = std::max(m_textWidth, insertedWidth);
+		else
+			this->updateTextWidth();
+
+		this->updateSelection();
+	}
 
-			int indexStart = row.start - start;
-			int indexEnd = row.end - start - 1;
+	void Caption::updateTextWidth()
+	{
+		m_textWidth = 0.f;
+		for(TextRow& row : m_textRows)
+			m_textWidth = std::max(m_textWidth, row.rect.w());
+	}
 
-			if(m_caret >= indexStart && m_caret <= indexEnd + 1)
+	void Caption::clearSelection()
+	{
+		for(size_t index : m_markedRows)
+			if(index < m_textRows.size())
 			{
-				float x, y;
-				this->caretCoords(x, y);
-				row.caret.assign(x, y, 2.f, row.rect.h());
+				m_textRows[index].selected.clear();
+				m_textRows[index].caret.clear();
 			}
 
-			if(m_selectStart != m_selectEnd && indexEnd > m_selectStart && indexStart < m_selectEnd)
+		m_markedRows.clear();
+	}
+
+	void Caption::updateSelection()
+	{
+		this->clearSelection();
+
+		if(m_textRows.empty())
+			return;
+
+		if(m_caret >= 0)
+		{
+			size_t index = this->rowIndex(m_caret);
+			TextRow& row = m_textRows[index];
+
+			float x, y;
+			this->caretCoords(x, y);
+			row.caret.assign(x, y, 2.f, row.rect.h());
+			m_markedRows.push_back(index);
+		}
+
+		if(m_selectStart == m_selectEnd)
+			return;
+
+		size_t firstRow = this->rowIndex(m_selectStart);
+		size_t lastRow = this->rowIndex(m_selectEnd);
+
+		for(size_t index = firstRow; index <= lastRow; ++index)
+		{
+			TextRow& row = m_textRows[index];
+
+			int indexStart = int(row.startIndex);
+			int indexEnd = int(row.endIndex) - 1;
+
+			if(indexEnd > m_selectStart && indexStart < m_selectEnd)
 			{
 				int lineSelectStart = std::max(indexStart, m_selectStart);
 				int lineSelectEnd = std::min(indexEnd, m_selectEnd);
 
+				m_markedRows.push_back(index);
+
 				if(row.glyphs.size() == 0)
 				{
 					row.selected.assign(row.rect.x(), row.rect.y(), 5.f, row.rect.h());
@@ -121,36 +256,50 @@ namespace toy
 		}
 	}
 
+	size_t Caption::rowIndex(size_t index)
+	{
+		auto byEnd = [](const TextRow& row, size_t index) { return row.endIndex < index; };
+		size_t row = std::lower_bound(m_textRows.begin(), m_textRows.end(), index, byEnd) - m_textRows.begin();
+		return std::min(row, m_textRows.size() - 1);
+	}
+
+	size_t Caption::rowAt(float y)
+	{
+		auto byTop = [](float y, const TextRow& row) { return y < row.rect.y(); };
+		size_t row = std::upper_bound(m_textRows.begin(), m_textRows.end(), y, byTop) - m_textRows.begin();
+		return row > 0 ? row - 1 : 0;
+	}
+
 	size_t Caption::caretIndex(float posX, float posY)
 	{
-		const char* start = m_frame.text().c_str();
-		const char* end = start + m_frame.text().size();
+		size_t end = m_frame.text().size();
 
-		for(TextRow& row : m_textRows)
-			if(posY >= row.rect.y() && posY < row.rect.y() + row.rect.h())
-			{
-				for(TextGlyph& glyph : row.glyphs)
-					if(posX >= glyph.rect.x() && posX < glyph.rect.x() + glyph.rect.w())
-						return glyph.position - start;
+		if(m_textRows.empty() || posY < m_textRows.front().rect.y())
+			return end;
 
-				return row.end - start;
-			}
+		TextRow& row = m_textRows[this->rowAt(posY)];
+		if(posY >= row.rect.y() + row.rect.h())
+			return end;
+
+		auto byLeft = [](float x, const TextGlyph& glyph) { return x < glyph.rect.x(); };
+		size_t glyph = std::upper_bound(row.glyphs.begin(), row.glyphs.end(), posX, byLeft) - row.glyphs.begin();
 
-		return end - start;
+		if(glyph > 0 && posX < row.glyphs[glyph - 1].rect.x() + row.glyphs[glyph - 1].rect.w())
+			return row.startIndex + glyph - 1;
+
+		return row.endIndex;
 	}
 
 	void Caption::caretCoords(float& x, float& y)
 	{
-		const char* start = m_frame.text().c_str();
-
 		TextRow& row = textRow(m_caret);
-				
-		if(m_caret != row.end - start)
+		size_t caret = size_t(m_caret);
+
+		if(caret >= row.startIndex && caret < row.endIndex && caret - row.startIndex < row.glyphs.size())
 		{
-			size_t offset = row.start - start;
-			TextGlyph& glyph = row.glyphs[m_caret - offset];
+			TextGlyph& glyph = row.glyphs[caret - row.startIndex];
 			x = glyph.rect.x();
-			y = glyph.rect.y();
+			y = row.rect.y();
 		}
 		else
 		{
@@ -161,12 +310,6 @@ namespace toy
 
 	TextRow& Caption::textRow(size_t index)
 	{
-		const char* start = m_frame.text().c_str();
-
-		for(TextRow& row : m_textRows)
-			if(index <= size_t(row.end - start))
-				return row;
-
-		return m_textRows.back();
+		return m_textRows[this->rowIndex(index)];
 	}
 }
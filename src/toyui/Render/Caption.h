@@ -15,7 +15,6 @@ namespace toy
 {
 	struct TextGlyph
 	{
-		const char* position;
 		BoxFloat rect;
 	};
 
@@ -47,17 +46,25 @@ namespace toy
 		void caret(int value) { m_caret = value; }
 
 		float textSize(Dimension dim);
+		float breakWidth() { return m_breakWidth; }
 
 		void redraw(Renderer& target, const BoxFloat& rect, const BoxFloat& paddedRect, const BoxFloat& contentRect);
 
-		void updateTextRows(Renderer& target, const DimFloat& space);
+		void updateTextRows(const FontMetrics& metrics, const DimFloat& space);
+		void editTextRows(const FontMetrics& metrics, const DimFloat& space, size_t position, size_t erased, size_t inserted);
 		void updateSelection();
 
 		TextRow& textRow(size_t index);
+		size_t rowIndex(size_t index);
+		size_t rowAt(float y);
 
 		size_t caretIndex(float x, float y);
 		void caretCoords(float& x, float& y);
 
+	protected:
+		void updateTextWidth();
+		void clearSelection();
+
 	protected:
 		DrawFrame& m_frame;
 
@@ -66,6 +73,10 @@ namespace toy
 		int m_selectEnd;
 
 		std::vector<TextRow> m_textRows;
+		std::vector<size_t> m_markedRows;
+
+		float m_textWidth;
+		float m_breakWidth;
 	};
 }
 
@@ -4,6 +4,7 @@
 
 #include <toyui/Config.h>
 #include <toyui/Render/DrawFrame.h>
+#include <toyui/Render/FontMetrics.h>
 
 #include <toyui/Frame/Frame.h>
 #include <toyui/Frame/Layer.h>
@@ -14,7 +15,7 @@
 
 namespace toy
 {
-	Renderer* DrawFrame::sRenderer = nullptr;
+	const FontMetrics* DrawFrame::sFontMetrics = nullptr;
 
 	string DrawFrame::sDebugDrawFilter = "";
 	bool DrawFrame::sDebugDrawFrameRect = false;
@@ -27,22 +28,71 @@ namespace toy
 		, d_stencil(*this)
 		, d_caption(*this)
 		, m_text()
+		, m_textRef(nullptr)
+		, m_textStamp(nullptr)
+		, m_textVersion(0)
 		, m_textLines(0)
 		, m_image(nullptr)
+		, m_contentStamp(1)
 		, d_inkstyle(nullptr)
+		, d_ownInkstyle()
 	{}
 
 	bool DrawFrame::empty()
 	{
-		return m_text.empty() && m_image == nullptr && d_inkstyle->image() == nullptr;
+		return this->text().empty() && m_image == nullptr && d_inkstyle->image() == nullptr;
 	}
 
 	void DrawFrame::setText(const string& text)
 	{
+		m_textRef = nullptr;
+		m_textStamp = nullptr;
 		m_text = text;
 		this->updateFrameSize();
 	}
 
+	void DrawFrame::setTextRef(const string& text, const size_t* stamp)
+	{
+		m_text.clear();
+		m_textRef = &text;
+		m_textStamp = stamp;
+		m_textVersion = stamp ? *stamp : 0;
+		this->updateFrameSize();
+	}
+
+	void DrawFrame::textChanged()
+	{
+		if(m_textStamp)
+			m_textVersion = *m_textStamp;
+		this->updateFrameSize();
+	}
+
+	void DrawFrame::updateTextRef()
+	{
+		if(m_textStamp && *m_textStamp != m_textVersion)
+			this->textChanged();
+	}
+
+	void DrawFrame::editText(size_t position, size_t erased, const string& inserted)
+	{
+		// edits are never written through to a referenced string
+		if(m_textRef)
+		{
+			m_text = *m_textRef;
+			m_textRef = nullptr;
+			m_textStamp = nullptr;
+		}
+
+		m_text.replace(position, erased, inserted);
+		++m_contentStamp;
+
+		if(!d_inkstyle)
+			return;
+
+		d_caption.editTextRows(*sFontMetrics, this->paddedSize(), position, erased, inserted.size());
+		d_frame->setDirty(Frame::DIRTY_CONTENT);
+	}
+
 	void DrawFrame::setImage(Image* image)
 	{
 		m_image = image;
@@ -60,11 +110,15 @@ namespace toy
 		if(!d_inkstyle->textWrap())
 			return;
 
-		this->updateTextLineBreaks();
+		// rows only depend on the width they were broken at, edits update them on their own
+		if(this->paddedSize().x() != d_caption.breakWidth())
+			this->updateTextLineBreaks();
 	}
 
 	void DrawFrame::updateFrameSize()
 	{
+		++m_contentStamp;
+
 		if(!d_inkstyle)
 			return;
 
@@ -73,13 +127,17 @@ namespace toy
 	}
 
 	void DrawFrame::updateTextLineBreaks()
+	{
+		++m_contentStamp;
+		d_caption.updateTextRows(*sFontMetrics, this->paddedSize());
+	}
+
+	DimFloat DrawFrame::paddedSize()
 	{
 		float paddedWidth = floor(d_frame->width() - d_inkstyle->padding().x0() - d_inkstyle->padding().x1());
 		float paddedHeight = floor(d_frame->height() - d_inkstyle->padding().y0() - d_inkstyle->padding().y1());
 
-		DimFloat paddedSize(paddedWidth, paddedHeight);
-
-		d_caption.updateTextRows(*sRenderer, paddedSize);
+		return DimFloat(paddedWidth, paddedHeight);
 	}
 
 	float DrawFrame::extentSize(Dimension dim)
@@ -92,12 +150,12 @@ namespace toy
 
 	float DrawFrame::contentSize(Dimension dim)
 	{
-		if(!m_text.empty())
+		if(!this->text().empty())
 			return d_caption.textSize(dim);
 		else if(m_image)
 			return dim == DIM_X ? float(m_image->d_width) : float(m_image->d_height);
 		else if(m_textLines && dim == DIM_Y)
-			return sRenderer->textLineHeight(*d_inkstyle) * m_textLines;
+			return sFontMetrics->lineHeight(d_inkstyle->textSize()) * m_textLines;
 		else if(d_inkstyle->image())
 			return dim == DIM_X ? float(d_inkstyle->image()->d_width) : float(d_inkstyle->image()->d_height);
 		else if(!d_inkstyle->imageSkin().null())
@@ -131,6 +189,13 @@ namespace toy
 			renderer.beginTarget();
 
 #ifdef TOYUI_DRAW_CACHE
+		if(this->offscreen(renderer))
+		{
+			renderer.beginTarget();
+			x = 0.f;
+			y = 0.f;
+		}
+
 		void* layerCache = nullptr;
 		renderer.layerCache(d_frame->layer(), layerCache);
 
@@ -145,6 +210,9 @@ namespace toy
 #else
 		renderer.beginUpdate(x, y);
 #endif
+
+		if(d_frame->alpha() < 1.f)
+			renderer.pushAlpha(d_frame->alpha());
 	}
 
 	void DrawFrame::draw(Renderer& renderer, bool force)
@@ -153,13 +221,16 @@ namespace toy
 		if(!(d_frame->layer().redraw() || force))
 			return;
 #endif
+		// only the frames of the layers being recorded are repainted, the others are replayed from the cache
+		renderer.countDrawn();
+
 		bool custom = d_frame->widget()->customDraw(renderer);
 		if(custom)
 			return;
 
-		if(d_inkstyle->customRenderer() != nullptr)
+		if(this->inkstyle().customRenderer() != nullptr)
 		{
-			CustomRenderer func = d_inkstyle->customRenderer();
+			CustomRenderer func = this->inkstyle().customRenderer();
 			custom = func(*d_frame, renderer);
 			if(custom)
 				return;
@@ -183,7 +254,7 @@ namespace toy
 		if(renderer.clipTest(rect))
 			return;
 
-		if(d_inkstyle->m_empty)
+		if(this->inkstyle().empty())
 			return;
 
 		float paddedLeft = floor(d_inkstyle->padding().x0());
@@ -222,6 +293,9 @@ namespace toy
 
 	void DrawFrame::endDraw(Renderer& renderer)
 	{
+		if(d_frame->alpha() < 1.f)
+			renderer.popAlpha();
+
 		renderer.endUpdate();
 
 		if(d_frame->frameType() >= LAYER)
@@ -229,17 +303,74 @@ namespace toy
 
 		if(d_frame->frameType() > LAYER)
 			renderer.endTarget();
+#ifdef TOYUI_DRAW_CACHE
+		else if(this->offscreen(renderer))
+			renderer.endTarget();
+#endif
+	}
+
+#ifdef TOYUI_DRAW_CACHE
+	bool DrawFrame::offscreen(Renderer& renderer)
+	{
+		return d_frame->frameType() == LAYER && d_frame->as<Layer>().offscreen() && renderer.supportsLayerTargets();
 	}
+#endif
 
 	void DrawFrame::resetInkstyle(InkStyle& inkstyle)
 	{
 		d_inkstyle = &inkstyle;
+		d_ownInkstyle.reset();
 		this->updateFrameSize();
 	}
 
+	InkStyle& DrawFrame::ownInkstyle()
+	{
+		// copies of a frame don't share the copy
+		if(!d_ownInkstyle || d_ownInkstyle.use_count() > 1)
+			d_ownInkstyle = std::make_shared<InkStyle>(this->inkstyle());
+		return *d_ownInkstyle;
+	}
+
 	void DrawFrame::updateInkstyle(InkStyle& inkstyle)
 	{
-		if(d_inkstyle != &inkstyle)
-			this->resetInkstyle(inkstyle);
+		if(d_inkstyle == &inkstyle)
+			return;
+
+		if(!d_inkstyle || !this->paintOnly(inkstyle))
+			return this->resetInkstyle(inkstyle);
+
+		// the text rows and the extent stay valid : the frame is only repainted, like a tweened colour
+		d_inkstyle = &inkstyle;
+		d_ownInkstyle.reset();
+		d_frame->setDirty(Frame::DIRTY_ABSOLUTE);
+		if(d_frame->frameType() >= LAYER)
+			d_frame->as<Layer>().setRedraw();
+	}
+
+	namespace
+	{
+		inline bool sameSize(Image* first, Image* second)
+		{
+			return first == second || (first && second && first->d_width == second->d_width && first->d_height == second->d_height);
+		}
+
+		inline bool sameSize(const ImageSkin& first, const ImageSkin& second)
+		{
+			if(first.null() || second.null())
+				return first.null() == second.null();
+			return first.d_stretch == second.d_stretch && first.d_solidWidth == second.d_solidWidth && first.d_solidHeight == second.d_solidHeight;
+		}
+	}
+
+	bool DrawFrame::paintOnly(InkStyle& inkstyle)
+	{
+		// everything the text rows and contentSize() read, the rest of the inkstyle is only painted
+		InkStyle& current = *d_inkstyle;
+		const BoxFloat& padding = current.padding();
+		const BoxFloat& otherPadding = inkstyle.padding();
+		return current.textFont() == inkstyle.textFont() && current.textSize() == inkstyle.textSize()
+			&& current.textBreak() == inkstyle.textBreak() && current.textWrap() == inkstyle.textWrap()
+			&& padding[0] == otherPadding[0] && padding[1] == otherPadding[1] && padding[2] == otherPadding[2] && padding[3] == otherPadding[3]
+			&& sameSize(current.image(), inkstyle.image()) && sameSize(current.imageSkin(), inkstyle.imageSkin());
 	}
 }
@@ -12,6 +12,9 @@
 #include <toyui/Render/Caption.h>
 #include <toyui/Render/Stencil.h>
 
+/* std */
+#include <memory>
+
 namespace toy
 {
 	class TOY_UI_EXPORT DrawFrame
@@ -29,31 +32,52 @@ namespace toy
 		void setEmpty() { this->setText(""); this->setImage(nullptr); }
 		bool empty();
 
-		const string& text() { return m_text; }
+		const string& text() { return m_textRef ? *m_textRef : m_text; }
 		void setText(const string& text);
+		void editText(size_t position, size_t erased, const string& inserted);
+
+		// display a string owned elsewhere : the owner bumps the stamp, or calls textChanged(), whenever it modifies it
+		void setTextRef(const string& text, const size_t* stamp = nullptr);
+		void textChanged();
+		void updateTextRef();
 
 		Image* image() { return m_image; }
 		void setImage(Image* image);
 
 		void setTextLines(size_t lines);
 
-		inline InkStyle& inkstyle() { return *d_inkstyle; }
+		// bumped whenever something the extent of the content depends on changes
+		size_t contentStamp() { return m_contentStamp; }
+
+		inline InkStyle& inkstyle() { return d_ownInkstyle ? *d_ownInkstyle : *d_inkstyle; }
+
+		// a copy of the inkstyle only this frame draws with, until the skin changes : tweened colours are written there
+		InkStyle& ownInkstyle();
 
 		void beginDraw(Renderer& renderer, bool force);
 		void draw(Renderer& renderer, bool force);
 		void endDraw(Renderer& renderer);
 
+		// switching to an inkstyle that only changes the paint keeps the layout, others break the text again
 		void updateInkstyle(InkStyle& inkstyle);
 		void resetInkstyle(InkStyle& inkstyle);
+		bool paintOnly(InkStyle& inkstyle);
 
 		void updateContentSize();
 		void updateFrameSize();
 		void updateTextLineBreaks();
 
+		DimFloat paddedSize();
+
 		float extentSize(Dimension dim);
 		float contentSize(Dimension dim);
 		void contentPos(const BoxFloat& paddedRect, const DimFloat& size, Dimension dim, DimFloat& pos);
 
+	protected:
+#ifdef TOYUI_DRAW_CACHE
+		bool offscreen(Renderer& renderer);
+#endif
+
 	protected:
 		Frame* d_frame;
 
@@ -62,13 +86,19 @@ namespace toy
 		//Image d_image;
 
 		string m_text;
+		const string* m_textRef;
+		const size_t* m_textStamp;
+		size_t m_textVersion;
 		size_t m_textLines;
 		Image* m_image;
+		size_t m_contentStamp;
 
 		InkStyle* d_inkstyle;
+		std::shared_ptr<InkStyle> d_ownInkstyle;
 
 	public:
-		static Renderer* sRenderer;
+		// text is measured and broken without a renderer
+		static const FontMetrics* sFontMetrics;
 
 		static string sDebugDrawFilter;
 		static bool sDebugDrawFrameRect;
@@ -0,0 +1,268 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Render/FontMetrics.h>
+
+#include <toyui/Style/Style.h>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb/stb_truetype.h>
+
+/* std */
+#include <cstdio>
+#include <algorithm>
+
+namespace toy
+{
+	FontMetrics::FontMetrics()
+		: m_data(nullptr)
+		, m_info(make_unique<stbtt_fontinfo>())
+		, m_ascent(0.f)
+		, m_height(1.f)
+		, m_lineGap(0.f)
+		, m_advances()
+		, m_kerning()
+	{}
+
+	FontMetrics::~FontMetrics()
+	{}
+
+	bool FontMetrics::load(const unsigned char* data, size_t size)
+	{
+		if(!data || size == 0 || !stbtt_InitFont(m_info.get(), data, stbtt_GetFontOffsetForIndex(data, 0)))
+		{
+			printf("Could not load font metrics\n");
+			return false;
+		}
+
+		int ascent, descent, lineGap;
+		stbtt_GetFontVMetrics(m_info.get(), &ascent, &descent, &lineGap);
+		m_ascent = float(ascent);
+		m_height = float(ascent - descent);
+		m_lineGap = float(lineGap);
+
+		std::vector<int> glyphs(s_tableSize);
+		m_advances.resize(s_tableSize);
+		for(uint32_t codepoint = 0; codepoint < s_tableSize; ++codepoint)
+		{
+			int lsb;
+			glyphs[codepoint] = stbtt_FindGlyphIndex(m_info.get(), codepoint);
+			stbtt_GetGlyphHMetrics(m_info.get(), glyphs[codepoint], &m_advances[codepoint], &lsb);
+		}
+
+		m_kerning.resize(s_tableSize * s_tableSize);
+		for(uint32_t first = 0; first < s_tableSize; ++first)
+			for(uint32_t second = 0; second < s_tableSize; ++second)
+				m_kerning[first * s_tableSize + second] = short(stbtt_GetGlyphKernAdvance(m_info.get(), glyphs[first], glyphs[second]));
+
+		m_data = data;
+		return true;
+	}
+
+	float FontMetrics::scale(float size) const
+	{
+		// nanovg quantizes font sizes to a tenth of a pixel
+		return float(short(size * 10.f)) / 10.f / m_height;
+	}
+
+	float FontMetrics::ascender(float size) const
+	{
+		return m_ascent * this->scale(size);
+	}
+
+	float FontMetrics::lineHeight(float size) const
+	{
+		return (m_height + m_lineGap) * this->scale(size);
+	}
+
+	uint32_t FontMetrics::decodeUtf8(const char*& iter, const char* end)
+	{
+		unsigned char c = *iter++;
+		if(c < 0x80)
+			return c;
+
+		int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+		uint32_t codepoint = c & (0x3F >> extra);
+		for(int i = 0; i < extra && iter < end && (*iter & 0xC0) == 0x80; ++i)
+			codepoint = (codepoint << 6) | (*iter++ & 0x3F);
+		return codepoint;
+	}
+
+	float FontMetrics::advance(uint32_t codepoint, uint32_t next, float size) const
+	{
+		if(!this->loaded())
+			return 0.f;
+
+		float scale = this->scale(size);
+
+		int advance, lsb;
+		if(codepoint < s_tableSize)
+			advance = m_advances[codepoint];
+		else
+			stbtt_GetCodepointHMetrics(m_info.get(), int(codepoint), &advance, &lsb);
+
+		// nanovg stores advances in tenths of pixels, and moves the pen by whole pixels
+		float pixels = float(int(float(short(scale * advance * 10.f)) / 10.f + 0.5f));
+
+		if(next)
+		{
+			int kern = codepoint < s_tableSize && next < s_tableSize ? m_kerning[codepoint * s_tableSize + next]
+																	: stbtt_GetCodepointKernAdvance(m_info.get(), int(codepoint), int(next));
+			pixels += float(int(kern * scale + 0.5f));
+		}
+
+		return pixels;
+	}
+
+	float FontMetrics::textWidth(const char* start, const char* end, float size) const
+	{
+		float width = 0.f;
+		const char* iter = start;
+		uint32_t codepoint = iter < end ? decodeUtf8(iter, end) : 0;
+		while(codepoint)
+		{
+			uint32_t next = iter < end ? decodeUtf8(iter, end) : 0;
+			width += this->advance(codepoint, next, size);
+			codepoint = next;
+		}
+		return width;
+	}
+
+	const char* FontMetrics::breakLine(const char* start, const char* end, float size, float width, float& lineWidth) const
+	{
+		const char* iter = start;
+		const char* wordEnd = nullptr;
+		float wordEndWidth = 0.f;
+		float pen = 0.f;
+
+		while(iter < end)
+		{
+			const char* glyphStart = iter;
+			uint32_t codepoint = decodeUtf8(iter, end);
+			if(codepoint == '\n')
+			{
+				lineWidth = pen;
+				return glyphStart;
+			}
+
+			if(codepoint == ' ' || codepoint == '\t')
+			{
+				wordEnd = glyphStart;
+				wordEndWidth = pen;
+			}
+
+			const char* peek = iter;
+			uint32_t next = peek < end ? decodeUtf8(peek, end) : 0;
+			float advance = this->advance(codepoint, next, size);
+			if(pen + advance > width && glyphStart > start)
+			{
+				// break after the last space, or in the middle of a word longer than the line
+				lineWidth = wordEnd ? wordEndWidth : pen;
+				return wordEnd ? wordEnd : glyphStart;
+			}
+
+			pen += advance;
+		}
+
+		lineWidth = pen;
+		return end;
+	}
+
+	void FontMetrics::fillRow(const char* start, const char* end, float y, float width, float size, TextRow& row) const
+	{
+		float lineHeight = this->lineHeight(size);
+
+		row.start = start;
+		row.end = end;
+		row.rect.assign(0.f, y, width, lineHeight);
+
+		// glyph rects are relative to their row vertically, so that rows can be moved without touching them
+		row.glyphs.resize(end - start);
+
+		float pen = 0.f;
+		const char* iter = start;
+		while(iter < end)
+		{
+			const char* glyphStart = iter;
+			uint32_t codepoint = decodeUtf8(iter, end);
+			const char* peek = iter;
+			uint32_t next = peek < end ? decodeUtf8(peek, end) : 0;
+			float advance = this->advance(codepoint, next, size);
+
+			for(const char* byte = glyphStart; byte < iter; ++byte)
+			{
+				float minx = byte == glyphStart ? pen : pen + advance;
+				row.glyphs[byte - start].rect.assign(minx, 0.f, pen + advance - minx, lineHeight);
+			}
+
+			pen += advance;
+		}
+	}
+
+	void FontMetrics::breakText(const string& text, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& rows) const
+	{
+		if(!skin.textBreak())
+		{
+			const char* start = text.c_str();
+			const char* end = start + text.size();
+
+			rows.resize(1);
+			this->fillRow(start, end, 0.f, this->textWidth(start, end, skin.textSize()), skin.textSize(), rows[0]);
+			rows[0].startIndex = 0;
+			rows[0].endIndex = text.size();
+			return;
+		}
+
+		this->breakTextRange(text, 0, text.size(), space, skin, rows);
+	}
+
+	void FontMetrics::breakTextRange(const string& text, size_t first, size_t end, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& rows) const
+	{
+		float size = skin.textSize();
+		float lineHeight = this->lineHeight(size);
+
+		const char* begin = text.c_str();
+		const char* iter = begin + first;
+		const char* last = begin + end;
+
+		rows.clear();
+
+		// every paragraph gives at least one row, so that an edit only ever needs to break the paragraphs it touches
+		while(true)
+		{
+			const char* paragraphEnd = std::find(iter, last, '\n');
+
+			do
+			{
+				size_t index = rows.size();
+				rows.resize(index + 1);
+				TextRow& row = rows.back();
+
+				if(skin.textWrap())
+				{
+					float width = 0.f;
+					const char* rowEnd = this->breakLine(iter, paragraphEnd, size, space.x(), width);
+					this->fillRow(iter, rowEnd, index * lineHeight, width, size, row);
+					iter = rowEnd < paragraphEnd && (*rowEnd == ' ' || *rowEnd == '\t') ? rowEnd + 1 : rowEnd;
+				}
+				else
+				{
+					this->fillRow(iter, paragraphEnd, index * lineHeight, this->textWidth(iter, paragraphEnd, size), size, row);
+					iter = paragraphEnd;
+				}
+
+				row.startIndex = row.start - begin;
+				row.endIndex = row.end - begin;
+			}
+			while(iter < paragraphEnd);
+
+			if(paragraphEnd == last)
+				break;
+
+			iter = paragraphEnd + 1;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_FONTMETRICS_H
+#define TOY_FONTMETRICS_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyui/Forward.h>
+#include <toyui/Style/Dim.h>
+#include <toyui/Render/Caption.h>
+
+/* std */
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+struct stbtt_fontinfo;
+
+namespace toy
+{
+	/* Measures text with the metrics of a truetype font, without any renderer or graphics context
+	 * The advances and kerning pairs of the latin-1 range are read once when loading, other codepoints are read from the font
+	 * Nothing is modified after loading and every query is const : text can be measured and broken from any thread
+	 * Advances are rounded to whole pixels the way nanovg draws them, so that the rows measured here match the drawn text
+	 */
+	class TOY_UI_EXPORT FontMetrics : public NonCopy
+	{
+	public:
+		FontMetrics();
+		~FontMetrics();
+
+		// the data is not copied and must outlive the metrics
+		bool load(const unsigned char* data, size_t size);
+		bool loaded() const { return m_data != nullptr; }
+
+		float ascender(float size) const;
+		float lineHeight(float size) const;
+
+		float advance(uint32_t codepoint, uint32_t next, float size) const;
+		float textWidth(const char* start, const char* end, float size) const;
+
+		// Returns the end of the longest run of words from start fitting in width
+		const char* breakLine(const char* start, const char* end, float size, float width, float& lineWidth) const;
+
+		// Breaks the text in rows fitting the space, with the extent of each glyph, as the captions lay them out
+		void breakText(const string& text, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& rows) const;
+		void breakTextRange(const string& text, size_t first, size_t end, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& rows) const;
+
+		static uint32_t decodeUtf8(const char*& iter, const char* end);
+
+		static const uint32_t s_tableSize = 256;
+
+	protected:
+		float scale(float size) const;
+		// one glyph per byte of the row, continuation bytes get an empty extent
+		void fillRow(const char* start, const char* end, float y, float width, float size, TextRow& row) const;
+
+	protected:
+		const unsigned char* m_data;
+		std::unique_ptr<stbtt_fontinfo> m_info;
+
+		// in font units
+		float m_ascent;
+		float m_height;
+		float m_lineGap;
+
+		std::vector<int> m_advances;
+		std::vector<short> m_kerning;
+	};
+}
+
+#endif // TOY_FONTMETRICS_H
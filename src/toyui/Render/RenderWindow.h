@@ -26,6 +26,8 @@ namespace toy
 		{}
 
 		virtual bool nextFrame() = 0;
+		virtual void makeCurrent() {}
+		virtual void setVsync(bool enabled) { UNUSED(enabled); }
 
 		string title() { return m_title; }
 		
@@ -26,7 +26,23 @@ namespace toy
 
 	Renderer::Renderer(const string& resourcePath)
 		: m_resourcePath(resourcePath)
+		, m_viewport()
+		, m_bounded(false)
+		, m_drawnFrames(0)
+		, m_culledFrames(0)
+		, m_drawCalls(0)
+		, m_unbatchedCalls(0)
+	{}
+
+	void Renderer::pushAlpha(float alpha)
+	{
+		m_alphas.push_back(this->alpha() * alpha);
+		this->applyAlpha(m_alphas.back());
+	}
+
+	void Renderer::popAlpha()
 	{
-		DrawFrame::sRenderer = this;
+		m_alphas.pop_back();
+		this->applyAlpha(this->alpha());
 	}
 }
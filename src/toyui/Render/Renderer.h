@@ -52,6 +52,11 @@ namespace toy
 		virtual void loadImage(Image& image) = 0;
 		virtual void unloadImage(Image& image) = 0;
 
+		// wrap the textures loaded by the renderer of another window, each renderer keeps its own index for every image
+		virtual bool shareResources(Renderer& source, RenderSystem& system) { UNUSED(source); UNUSED(system); return false; }
+		// take over the shared textures when the renderer that loaded them is closed first, they are deleted with the adopting renderer
+		virtual bool adoptResources(Renderer& owner) { UNUSED(owner); return false; }
+
 		// rendering
 		virtual void render(RenderTarget& target) = 0;
 
@@ -66,11 +71,19 @@ namespace toy
 
 		virtual void beginUpdate(void* layerCache, float x, float y, float scale = 1.f) = 0;
 		virtual void endUpdate() = 0;
+
+		// offscreen layers are recorded in their own coordinates, rasterized in a texture and composited as one quad
+		virtual bool supportsLayerTargets() { return false; }
 #else
 		virtual void beginUpdate(float x, float y) = 0;
 		virtual void endUpdate() = 0;
 #endif
 
+		// opacity : the alpha pushed by a frame multiplies everything drawn until it is popped, nested alphas multiply
+		void pushAlpha(float alpha);
+		void popAlpha();
+		float alpha() { return m_alphas.empty() ? 1.f : m_alphas.back(); }
+
 		virtual bool clipTest(const BoxFloat& rect) = 0;
 		virtual void clipRect(const BoxFloat& rect) = 0;
 		virtual void unclipRect() = 0;
@@ -88,18 +101,43 @@ namespace toy
 
 		virtual void drawImage(const Image& image, const BoxFloat& rect) = 0;
 		virtual void drawImageStretch(const Image& image, const BoxFloat& rect, float xstretch = 1.f, float ystretch = 1.f) = 0;
+		virtual void drawSprite(const Sprite& sprite, const BoxFloat& rect, float xstretch = 1.f, float ystretch = 1.f) = 0;
 
 		virtual void debugRect(const BoxFloat& rect, const Colour& colour) = 0;
 
-		virtual void fillText(const string& text, const BoxFloat& rect, InkStyle& skin, TextRow& row) = 0;
-		virtual void breakText(const string& text, const DimFloat& space, InkStyle& skin, std::vector<TextRow>& rows) = 0;
+		// culling : the viewport is the visible rect in the local coordinates of the frame being rendered
+		const BoxFloat& viewport() { return m_viewport; }
+		bool bounded() { return m_bounded; }
+		void setViewport(const BoxFloat& viewport, bool bounded) { m_viewport = viewport; m_bounded = bounded; }
+
+		// a frame painted again, a frame replayed from its layer cache is not counted
+		void countDrawn() { ++m_drawnFrames; }
+		void countCulled() { ++m_culledFrames; }
+		void countDrawCalls(size_t count) { m_drawCalls += count; m_unbatchedCalls += count; }
+		// a batch of items drawn in count calls, where drawing them one by one would take one call per item
+		void countBatch(size_t count, size_t items) { m_drawCalls += count; m_unbatchedCalls += items; }
+		void resetCounts() { m_drawnFrames = 0; m_culledFrames = 0; m_drawCalls = 0; m_unbatchedCalls = 0; }
 
-		virtual float textLineHeight(InkStyle& skin) = 0;
-		virtual float textSize(const string& text, Dimension dim, InkStyle& skin) = 0;
+		size_t drawnFrames() { return m_drawnFrames; }
+		size_t culledFrames() { return m_culledFrames; }
+		size_t drawCalls() { return m_drawCalls; }
+		size_t unbatchedCalls() { return m_unbatchedCalls; }
+
+	protected:
+		virtual void applyAlpha(float alpha) { UNUSED(alpha); }
 
 	protected:
 		string m_resourcePath;
 		int m_debugBatch;
+
+		std::vector<float> m_alphas;
+
+		BoxFloat m_viewport;
+		bool m_bounded;
+		size_t m_drawnFrames;
+		size_t m_culledFrames;
+		size_t m_drawCalls;
+		size_t m_unbatchedCalls;
 	};
 }
 
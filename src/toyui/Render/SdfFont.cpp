@@ -0,0 +1,180 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Render/SdfFont.h>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb/stb_truetype.h>
+
+/* std */
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+namespace toy
+{
+	static const unsigned char s_onEdge = 128;
+
+	SdfFont::SdfFont(float baseSize, int padding, int atlasSize)
+		: m_baseSize(baseSize)
+		, m_padding(padding)
+		, m_atlasSize(atlasSize)
+		, m_info(make_unique<stbtt_fontinfo>())
+		, m_scale(1.f)
+		, m_metrics()
+		, m_atlas(atlasSize * atlasSize, 0)
+		, m_atlasDirty(false)
+		, m_shelfX(0)
+		, m_shelfY(0)
+		, m_shelfHeight(0)
+	{}
+
+	SdfFont::~SdfFont()
+	{}
+
+	bool SdfFont::load(const string& path)
+	{
+		FILE* file = fopen(path.c_str(), "rb");
+		if(!file)
+		{
+			printf("Could not open font %s\n", path.c_str());
+			return false;
+		}
+
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		m_data.resize(size);
+		size_t read = fread(m_data.data(), 1, size, file);
+		fclose(file);
+
+		if(read != size_t(size) || !stbtt_InitFont(m_info.get(), m_data.data(), stbtt_GetFontOffsetForIndex(m_data.data(), 0)))
+		{
+			printf("Could not load font %s\n", path.c_str());
+			m_data.clear();
+			return false;
+		}
+
+		m_scale = stbtt_ScaleForPixelHeight(m_info.get(), m_baseSize);
+		return m_metrics.load(m_data.data(), m_data.size());
+	}
+
+	bool SdfFont::pack(int width, int height, int& x, int& y)
+	{
+		if(m_shelfX + width > m_atlasSize)
+		{
+			m_shelfX = 0;
+			m_shelfY += m_shelfHeight;
+			m_shelfHeight = 0;
+		}
+
+		if(m_shelfY + height > m_atlasSize)
+			return false;
+
+		x = m_shelfX;
+		y = m_shelfY;
+		m_shelfX += width;
+		m_shelfHeight = std::max(m_shelfHeight, height);
+		return true;
+	}
+
+	const SdfGlyph* SdfFont::glyph(uint32_t codepoint)
+	{
+		auto it = m_glyphs.find(codepoint);
+		if(it != m_glyphs.end())
+			return &it->second;
+
+		if(!this->loaded())
+			return nullptr;
+
+		SdfGlyph& glyph = m_glyphs[codepoint];
+		glyph = { 0, 0, 0, 0, 0.f, 0.f };
+
+		float pixelDistScale = float(s_onEdge) / float(m_padding);
+		int width, height, xoff, yoff;
+		unsigned char* bitmap = stbtt_GetCodepointSDF(m_info.get(), m_scale, codepoint, m_padding, s_onEdge, pixelDistScale, &width, &height, &xoff, &yoff);
+		if(!bitmap)
+			return &glyph; // blank glyph like a space
+
+		int x, y;
+		if(this->pack(width, height, x, y))
+		{
+			for(int row = 0; row < height; ++row)
+				std::copy(bitmap + row * width, bitmap + (row + 1) * width, m_atlas.begin() + (y + row) * m_atlasSize + x);
+
+			glyph = { x, y, width, height, float(xoff), float(yoff) };
+			m_atlasDirty = true;
+		}
+		else
+		{
+			printf("WARNING: SDF font atlas is full, glyph %u dropped\n", codepoint);
+		}
+
+		stbtt_FreeSDF(bitmap, nullptr);
+		return &glyph;
+	}
+
+	void SdfFont::emitText(SdfTextBatch& batch, float x, float y, const char* start, const char* end, float size, const Colour& colour, const float* t, const BoxFloat& scissor)
+	{
+		float ratio = size / m_baseSize;
+		float screenScale = std::sqrt(t[0] * t[0] + t[1] * t[1]);
+		// distance field units to screen pixels
+		float sharpness = 255.f / (float(s_onEdge) / float(m_padding)) * ratio * screenScale;
+
+		float baseline = y + this->ascender(size);
+		float pen = x;
+		float inv = 1.f / float(m_atlasSize);
+		bool clip = scissor.w() >= 0.f && scissor.h() >= 0.f;
+
+		const char* iter = start;
+		uint32_t codepoint = iter < end ? FontMetrics::decodeUtf8(iter, end) : 0;
+		while(codepoint)
+		{
+			uint32_t next = iter < end ? FontMetrics::decodeUtf8(iter, end) : 0;
+			const SdfGlyph* glyph = this->glyph(codepoint);
+
+			if(glyph && glyph->d_width > 0)
+			{
+				float x0 = pen + glyph->d_xoff * ratio;
+				float y0 = baseline + glyph->d_yoff * ratio;
+				float x1 = x0 + glyph->d_width * ratio;
+				float y1 = y0 + glyph->d_height * ratio;
+
+				float u0 = glyph->d_x * inv;
+				float v0 = glyph->d_y * inv;
+				float u1 = (glyph->d_x + glyph->d_width) * inv;
+				float v1 = (glyph->d_y + glyph->d_height) * inv;
+
+				if(clip)
+				{
+					float cx0 = std::max(x0, scissor.x()), cy0 = std::max(y0, scissor.y());
+					float cx1 = std::min(x1, scissor.x() + scissor.w()), cy1 = std::min(y1, scissor.y() + scissor.h());
+					if(cx0 < cx1 && cy0 < cy1)
+					{
+						float du = (u1 - u0) / (x1 - x0), dv = (v1 - v0) / (y1 - y0);
+						u0 += (cx0 - x0) * du; u1 -= (x1 - cx1) * du;
+						v0 += (cy0 - y0) * dv; v1 -= (y1 - cy1) * dv;
+					}
+					x0 = cx0; y0 = cy0; x1 = cx1; y1 = cy1;
+				}
+
+				if(x0 < x1 && y0 < y1)
+				{
+					auto vertex = [&](float vx, float vy, float u, float v) {
+						batch.push_back({ t[0] * vx + t[2] * vy + t[4], t[1] * vx + t[3] * vy + t[5], u, v, colour.r(), colour.g(), colour.b(), colour.a(), sharpness });
+					};
+
+					vertex(x0, y0, u0, v0); vertex(x1, y0, u1, v0); vertex(x1, y1, u1, v1);
+					vertex(x0, y0, u0, v0); vertex(x1, y1, u1, v1); vertex(x0, y1, u0, v1);
+				}
+			}
+
+			pen += this->advance(codepoint, next, size);
+			codepoint = next;
+		}
+	}
+}
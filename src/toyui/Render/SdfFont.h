@@ -0,0 +1,100 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_SDFFONT_H
+#define TOY_SDFFONT_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyobj/Util/Colour.h>
+#include <toyui/Forward.h>
+#include <toyui/Style/Dim.h>
+#include <toyui/Render/FontMetrics.h>
+
+/* std */
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+struct stbtt_fontinfo;
+
+namespace toy
+{
+	struct SdfGlyph
+	{
+		int d_x;
+		int d_y;
+		int d_width;
+		int d_height;
+		float d_xoff;
+		float d_yoff;
+	};
+
+	struct SdfVertex
+	{
+		float x, y;
+		float u, v;
+		float r, g, b, a;
+		float sharpness;
+	};
+
+	typedef std::vector<SdfVertex> SdfTextBatch;
+
+	/* Signed distance field glyph atlas
+	 * Glyphs are rendered once at the base size into a single channel atlas, on first use
+	 * Any text size is then drawn from the same glyphs, the shader thresholds the distance to keep edges sharp
+	 */
+	class TOY_UI_EXPORT SdfFont : public NonCopy
+	{
+	public:
+		SdfFont(float baseSize = 32.f, int padding = 6, int atlasSize = 1024);
+		~SdfFont();
+
+		bool load(const string& path);
+		bool loaded() { return !m_data.empty(); }
+
+		int atlasSize() { return m_atlasSize; }
+		const unsigned char* atlas() { return m_atlas.data(); }
+
+		bool atlasDirty() { return m_atlasDirty; }
+		void setAtlasDirty() { m_atlasDirty = true; }
+		void clearAtlasDirty() { m_atlasDirty = false; }
+
+		const FontMetrics& metrics() { return m_metrics; }
+
+		float ascender(float size) { return m_metrics.ascender(size); }
+		float lineHeight(float size) { return m_metrics.lineHeight(size); }
+
+		float advance(uint32_t codepoint, uint32_t next, float size) { return m_metrics.advance(codepoint, next, size); }
+		float textWidth(const char* start, const char* end, float size) { return m_metrics.textWidth(start, end, size); }
+
+		void emitText(SdfTextBatch& batch, float x, float y, const char* start, const char* end, float size, const Colour& colour, const float* transform, const BoxFloat& scissor);
+
+		const SdfGlyph* glyph(uint32_t codepoint);
+
+	protected:
+		bool pack(int width, int height, int& x, int& y);
+
+	protected:
+		float m_baseSize;
+		int m_padding;
+		int m_atlasSize;
+
+		std::vector<unsigned char> m_data;
+		std::unique_ptr<stbtt_fontinfo> m_info;
+		float m_scale;
+		FontMetrics m_metrics;
+
+		std::vector<unsigned char> m_atlas;
+		bool m_atlasDirty;
+		int m_shelfX;
+		int m_shelfY;
+		int m_shelfHeight;
+
+		std::unordered_map<uint32_t, SdfGlyph> m_glyphs;
+	};
+}
+
+#endif // TOY_SDFFONT_H
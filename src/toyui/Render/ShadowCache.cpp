@@ -0,0 +1,109 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/Render/ShadowCache.h>
+
+/* std */
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+namespace toy
+{
+	static uint64_t shadowKey(float radius, float blur, const Colour& colour)
+	{
+		// quarter pixel steps are indistinguishable on a blurred edge
+		uint64_t quantRadius = uint64_t(std::min(std::max(radius * 4.f, 0.f), 65535.f));
+		uint64_t quantBlur = uint64_t(std::min(std::max(blur * 4.f, 0.f), 65535.f));
+		uint64_t rgba = (uint64_t(colour.r() * 255.f) << 24) | (uint64_t(colour.g() * 255.f) << 16) | (uint64_t(colour.b() * 255.f) << 8) | uint64_t(colour.a() * 255.f);
+		return (quantRadius << 48) | (quantBlur << 32) | rgba;
+	}
+
+	ShadowCache::ShadowCache(int atlasSize)
+		: m_atlasSize(atlasSize)
+		, m_atlas(atlasSize * atlasSize * 4, 0)
+		, m_atlasDirty(false)
+		, m_shelfX(0)
+		, m_shelfY(0)
+		, m_shelfHeight(0)
+		, m_full(false)
+	{}
+
+	bool ShadowCache::pack(int width, int height, int& x, int& y)
+	{
+		if(m_shelfX + width > m_atlasSize)
+		{
+			m_shelfX = 0;
+			m_shelfY += m_shelfHeight;
+			m_shelfHeight = 0;
+		}
+
+		if(m_shelfY + height > m_atlasSize)
+			return false;
+
+		x = m_shelfX;
+		y = m_shelfY;
+		m_shelfX += width;
+		m_shelfHeight = std::max(m_shelfHeight, height);
+		return true;
+	}
+
+	const ShadowSlices* ShadowCache::slices(float radius, float blur, const Colour& colour)
+	{
+		uint64_t key = shadowKey(radius, blur, colour);
+		auto it = m_slices.find(key);
+		if(it != m_slices.end())
+			return &it->second;
+
+		// the gradient reaches half the blur outside of the shape, the corners curve the inside up to their radius
+		float feather = std::max(blur, 1.f);
+		int margin = int(std::ceil(feather * 0.5f)) + 1;
+		int inside = int(std::ceil(std::max(radius, feather * 0.5f))) + 1;
+
+		ShadowSlices slices;
+		slices.d_margin = margin;
+		slices.d_corner = margin + inside;
+		slices.d_size = slices.d_corner * 2 + s_strip;
+
+		// one pixel of transparent padding keeps the filtering of neighbours apart
+		if(!this->pack(slices.d_size + 1, slices.d_size + 1, slices.d_x, slices.d_y))
+		{
+			if(!m_full)
+				printf("Shadow atlas is full, the next shadows are drawn with gradients\n");
+			m_full = true;
+			return nullptr;
+		}
+
+		this->rasterize(slices, radius, feather, colour);
+		m_atlasDirty = true;
+
+		return &(m_slices[key] = slices);
+	}
+
+	void ShadowCache::rasterize(const ShadowSlices& slices, float radius, float feather, const Colour& colour)
+	{
+		// same rounded box distance and ramp as the nanovg box gradient
+		float half = (slices.d_size - 2 * slices.d_margin) * 0.5f;
+		float center = slices.d_size * 0.5f;
+		float r = std::min(radius, half);
+
+		for(int y = 0; y < slices.d_size; ++y)
+			for(int x = 0; x < slices.d_size; ++x)
+			{
+				float dx = std::abs(x + 0.5f - center) - (half - r);
+				float dy = std::abs(y + 0.5f - center) - (half - r);
+				float outside = std::sqrt(std::max(dx, 0.f) * std::max(dx, 0.f) + std::max(dy, 0.f) * std::max(dy, 0.f));
+				float distance = std::min(std::max(dx, dy), 0.f) + outside - r;
+
+				float alpha = colour.a() * (1.f - std::min(std::max((distance + feather * 0.5f) / feather, 0.f), 1.f));
+
+				unsigned char* pixel = &m_atlas[((slices.d_y + y) * m_atlasSize + slices.d_x + x) * 4];
+				pixel[0] = (unsigned char)(colour.r() * 255.f);
+				pixel[1] = (unsigned char)(colour.g() * 255.f);
+				pixel[2] = (unsigned char)(colour.b() * 255.f);
+				pixel[3] = (unsigned char)(alpha * 255.f + 0.5f);
+			}
+	}
+}
@@ -0,0 +1,68 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_SHADOWCACHE_H
+#define TOY_SHADOWCACHE_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyobj/Util/Colour.h>
+#include <toyui/Forward.h>
+
+/* std */
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace toy
+{
+	// A shadow rasterized in the atlas : four corners, and a center strip between them which is stretched along the edges
+	struct ShadowSlices
+	{
+		int d_x;
+		int d_y;
+		int d_size;
+		int d_corner;
+		// distance from the border of the image to the edge of the shadowed shape
+		int d_margin;
+	};
+
+	/* Shadow box gradients rasterized once per corner radius, blur and colour, in an RGBA atlas
+	 * The spread only grows the shape and its radius, so shadows differing by the spread alone share their slices when the radii match
+	 * A shadow is then drawn as nine slices of the atlas, whatever the size of the shadowed frame
+	 */
+	class TOY_UI_EXPORT ShadowCache : public NonCopy
+	{
+	public:
+		ShadowCache(int atlasSize = 512);
+
+		int atlasSize() { return m_atlasSize; }
+		const unsigned char* atlas() { return m_atlas.data(); }
+
+		bool atlasDirty() { return m_atlasDirty; }
+		void clearAtlasDirty() { m_atlasDirty = false; }
+
+		// the stretched strip is sampled in its middle, so that the filtering never reaches the corners
+		static const int s_strip = 4;
+
+		const ShadowSlices* slices(float radius, float blur, const Colour& colour);
+
+	protected:
+		bool pack(int width, int height, int& x, int& y);
+		void rasterize(const ShadowSlices& slices, float radius, float feather, const Colour& colour);
+
+	protected:
+		int m_atlasSize;
+		std::vector<unsigned char> m_atlas;
+		bool m_atlasDirty;
+		int m_shelfX;
+		int m_shelfY;
+		int m_shelfHeight;
+		bool m_full;
+
+		std::unordered_map<uint64_t, ShadowSlices> m_slices;
+	};
+}
+
+#endif // TOY_SHADOWCACHE_H
@@ -56,12 +56,12 @@ namespace toy
 		// Rect
 		if((skin.borderWidth().x0() || skin.backgroundColour().a() > 0.f))
 		{
-			BoxFloat cornerRadius = skin.m_weakCorners ? this->selectCorners() : skin.cornerRadius();
+			BoxFloat cornerRadius = skin.weakCorners() ? this->selectCorners() : skin.cornerRadius();
 			target.drawRect(rect, cornerRadius, skin);
 		}
 
 		// ImageSkin
-		ImageSkin& imageSkin = skin.imageSkin();
+		const ImageSkin& imageSkin = skin.imageSkin();
 		if(!imageSkin.null())
 		{
 			BoxFloat skinRect;
@@ -88,7 +88,7 @@ namespace toy
 
 	void Stencil::drawSkinImage(Renderer& target, ImageSkin::Section section, int left, int top, int width, int height)
 	{
-		ImageSkin& imageSkin = m_frame.inkstyle().imageSkin();
+		const ImageSkin& imageSkin = m_frame.inkstyle().imageSkin();
 		left -= imageSkin.d_margin;
 		top -= imageSkin.d_margin;
 
@@ -101,6 +101,6 @@ namespace toy
 			yratio = float(height) / imageSkin.d_fillHeight;
 
 		BoxFloat rect(left, top, width, height);
-		target.drawImageStretch(imageSkin.d_images[section], rect, xratio, yratio);
+		target.drawSprite(imageSkin.d_sprites[section], rect, xratio, yratio);
 	}
 }
@@ -16,6 +16,7 @@
 #include <toyui/Image.h>
 
 /* std */
+#include <array>
 #include <vector>
 #include <functional>
 
@@ -52,8 +53,6 @@ namespace toy
 			, d_top(top), d_right(right), d_bottom(bottom), d_left(left)
 			, d_margin(margin)
 			, d_stretch(stretch)
-			, d_images(9)
-			, d_prepared(false)
 		{
 			this->setupImage(*d_image);
 		}
@@ -67,24 +66,6 @@ namespace toy
 		void setupImage(Image& image)
 		{
 			d_image = &image;
-			d_images[TOP_LEFT].d_name = image.d_name + "_topleft";
-			d_images[TOP_RIGHT].d_name = image.d_name + "_topright";
-			d_images[BOTTOM_RIGHT].d_name = image.d_name + "_bottomright";
-			d_images[BOTTOM_LEFT].d_name = image.d_name + "_bottomleft";
-
-			d_images[TOP].d_name = image.d_name + "_top";
-			d_images[RIGHT].d_name = image.d_name + "_right";
-			d_images[BOTTOM].d_name = image.d_name + "_bottom";
-			d_images[LEFT].d_name = image.d_name + "_left";
-
-			d_images[FILL].d_name = image.d_name + "_fill";
-
-			for(size_t i = 0; i < 9; ++i)
-			{
-				d_images[i].d_index = d_image->d_index;
-				d_images[i].d_atlas = d_image->d_atlas;
-			}
-
 			this->setupSize(image.d_width, image.d_height);
 		}
 
@@ -98,11 +79,14 @@ namespace toy
 			d_solidWidth = width - d_margin - d_margin;
 			d_solidHeight = height - d_margin - d_margin;
 
-			this->stretchCoords(0, 0, width, height, [this](Section s, int x, int y, int w, int h) {
-				this->d_images[s].d_left = this->d_image->d_left + x;
-				this->d_images[s].d_top = this->d_image->d_top + y;
-				this->d_images[s].d_width = w;
-				this->d_images[s].d_height = h;
+			Sprite source(*d_image);
+			this->stretchCoords(0, 0, width, height, [this, &source](Section s, int x, int y, int w, int h) {
+				Sprite& sprite = this->d_sprites[s];
+				sprite = source;
+				sprite.d_left = source.d_left + x;
+				sprite.d_top = source.d_top + y;
+				sprite.d_width = w;
+				sprite.d_height = h;
 			 });
 		}
 
@@ -143,9 +127,7 @@ namespace toy
 		int d_fillWidth;
 		int d_fillHeight;
 
-		std::vector<Image> d_images;
-
-		bool d_prepared;
+		std::array<Sprite, 9> d_sprites;
 
 		static Type& cls() { static Type ty; return ty; }
 	};
@@ -15,11 +15,11 @@ namespace toy
 {
 	void InkStyle::prepare()
 	{
-		if(m_base)
-			this->inherit(m_base.val->skin());
+		if(this->base())
+			this->inherit(this->base()->skin());
 
 		if(backgroundColour().a() > 0.f || textColour().a() > 0.f || borderColour().a() > 0.f || image() || !imageSkin().null())
-			m_empty = false;
+			this->setEmpty(false);
 	}
 
 	Style::Style(Type& type, Style* base)
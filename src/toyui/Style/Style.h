@@ -17,6 +17,10 @@
 /* Standards */
 #include <array>
 #include <map>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <cstdint>
 
 namespace toy
 {
@@ -46,91 +50,158 @@ namespace toy
 		static Type& cls() { static Type ty(INDEXED); return ty; }
 	};
 
+	/* Heavy style values are held by a reference counted handle : styles inheriting them share a single copy
+	 * Editing the value through a handle still shared with other styles detaches it first
+	 */
 	template <class T>
-	class StyleAttr
+	class StyleShared
 	{
 	public:
-		StyleAttr() : val(), set(false) {}
-		StyleAttr(const T& v) : val(v), set(false) {}
-		StyleAttr(const StyleAttr& other) : val(other.val), set(other.set) {}
+		StyleShared() : m_value(null()) {}
+		StyleShared(const T& value) : m_value(std::make_shared<T>(value)) {}
 
-		operator const T&() const { return val; }
-		StyleAttr& operator=(const T& v) { val = v; set = true; return *this; }
-		StyleAttr& operator=(const StyleAttr& other) { val = other.val; set = other.set; return *this; }
+		operator const T&() const { return *m_value; }
+		const T& get() const { return *m_value; }
 
-		void copy(const StyleAttr& other, bool inherit) { if(set && (inherit || !other.set)) return; val = other.val; if(!inherit) set = other.set; }
+		T& edit() { if(m_value.use_count() > 1) m_value = std::make_shared<T>(*m_value); return *m_value; }
 
-		T val;
-		bool set;
+	protected:
+		static const std::shared_ptr<T>& null() { static std::shared_ptr<T> value = std::make_shared<T>(); return value; }
+
+		std::shared_ptr<T> m_value;
+	};
+
+	/* Style properties are stored in a table indexed at compile time, along with a mask of the properties explicitly set
+	 * Inheriting or copying a style only walks the properties selected by the mask
+	 */
+	template <class... T_Properties>
+	class StyleProperties
+	{
+	public:
+		template <size_t I>
+		using Type = typename std::tuple_element<I, std::tuple<T_Properties...>>::type;
+
+		static const uint32_t s_all = uint32_t((uint64_t(1) << sizeof...(T_Properties)) - 1);
+
+		StyleProperties(const T_Properties&... values) : m_values(values...), m_set(0) {}
+
+		template <size_t I>
+		const Type<I>& get() const { return std::get<I>(m_values); }
+
+		template <size_t I>
+		Type<I>& ref() { return std::get<I>(m_values); }
+
+		template <size_t I>
+		void set(const Type<I>& value) { std::get<I>(m_values) = value; m_set |= (1 << I); }
+
+		template <size_t I>
+		bool isSet() const { return (m_set & (1 << I)) != 0; }
+
+		uint32_t setMask() const { return m_set; }
+
+		void copy(const StyleProperties& other, bool inherit, uint32_t filter = s_all)
+		{
+			// inheriting fills all the properties not set, copying leaves out only those set here and not in other
+			uint32_t mask = (inherit ? ~m_set : (other.m_set | ~m_set)) & filter & s_all;
+			if(mask == 0)
+				return;
+
+			this->copyMasked(other, mask, std::index_sequence_for<T_Properties...>());
+
+			if(!inherit)
+				m_set = (m_set & ~mask) | (other.m_set & mask);
+		}
+
+	protected:
+		template <size_t... Is>
+		void copyMasked(const StyleProperties& other, uint32_t mask, std::index_sequence<Is...>)
+		{
+			int expand[] = { 0, ((mask & (1 << Is)) ? (void)(std::get<Is>(m_values) = std::get<Is>(other.m_values)), 0 : 0)... };
+			(void) expand;
+		}
+
+	protected:
+		std::tuple<T_Properties...> m_values;
+		uint32_t m_set;
 	};
 
 	class _I_ TOY_UI_EXPORT LayoutStyle : public IdStruct
 	{
+	public:
+		enum Property
+		{
+			LAYOUT_LAYOUT,
+			LAYOUT_FLOW,
+			LAYOUT_SPACE,
+			LAYOUT_CLIPPING,
+			LAYOUT_OPACITY,
+			LAYOUT_DIRECTION,
+			LAYOUT_ALIGN,
+			LAYOUT_SPAN,
+			LAYOUT_SIZE,
+			LAYOUT_PADDING,
+			LAYOUT_MARGIN,
+			LAYOUT_SPACING,
+			LAYOUT_PIVOT,
+			LAYOUT_ZORDER
+		};
+
+		typedef StyleProperties<DimLayout, Flow, Space, Clipping, Opacity, Direction, DimAlign, DimFloat, DimFloat, BoxFloat, DimFloat, DimFloat, DimPivot, int> Properties;
+
 	public:
 		LayoutStyle()
 			: IdStruct(cls())
-			, d_layout(DimLayout(AUTO_LAYOUT, AUTO_LAYOUT)), d_flow(FLOW), d_clipping(NOCLIP), d_opacity(CLEAR), d_space(SHEET), d_direction(DIRECTION_AUTO), d_align(DimAlign(LEFT, LEFT))
-			, d_span(DimFloat(1.f, 1.f)), d_pivot(DimPivot(FORWARD, FORWARD)), d_zorder(0), d_updated(0)
+			, d_properties(DimLayout(AUTO_LAYOUT, AUTO_LAYOUT), FLOW, SHEET, NOCLIP, CLEAR, DIRECTION_AUTO, DimAlign(LEFT, LEFT)
+						 , DimFloat(1.f, 1.f), DimFloat(), BoxFloat(), DimFloat(), DimFloat(), DimPivot(FORWARD, FORWARD), 0)
+			, d_updated(0)
 		{}
 
 		LayoutStyle(const LayoutStyle& other)
 			: IdStruct(cls())
-		{
-			this->copy(other);
-		}
+			, d_properties(other.d_properties)
+			, d_updated(other.d_updated)
+		{}
 
 		LayoutStyle& operator=(const LayoutStyle&) = default;
 
-		void copy(const LayoutStyle& other, bool inherit)
-		{
-			d_layout.copy(other.d_layout, inherit);
-			d_flow.copy(other.d_flow, inherit);
-			d_space.copy(other.d_space, inherit);
-			d_clipping.copy(other.d_clipping, inherit);
-			d_opacity.copy(other.d_opacity, inherit);
-			d_direction.copy(other.d_direction, inherit);
-			d_align.copy(other.d_align, inherit);
-			d_span.copy(other.d_span, inherit);
-			d_size.copy(other.d_size, inherit);
-			d_padding.copy(other.d_padding, inherit);
-			d_margin.copy(other.d_margin, inherit);
-			d_spacing.copy(other.d_spacing, inherit);
-			d_pivot.copy(other.d_pivot, inherit);
-			d_zorder.copy(other.d_zorder, inherit);
-		}
+		void copy(const LayoutStyle& other, bool inherit) { d_properties.copy(other.d_properties, inherit); }
 
 		void inherit(const LayoutStyle& other) { return this->copy(other, true); }
 		void copy(const LayoutStyle& other) { return this->copy(other, false); }
 
-		/*_A_*/ DimLayout layout() const { return d_layout.val; }
-		/*_A_*/ Flow flow() const { return d_flow.val; }
-		/*_A_*/ Space space() const { return d_space.val; }
-		/*_A_*/ Clipping clipping() const { return d_clipping.val; }
-		/*_A_*/ Opacity opacity() const { return d_opacity.val; }
-		/*_A_*/ Direction direction() const { return d_direction.val; }
-		/*_A_*/ DimAlign& align() { return d_align.val; }
-		/*_A_*/ DimFloat& span() { return d_span.val; }
-		/*_A_*/ DimFloat& size() { return d_size.val; }
-		/*_A_*/ BoxFloat& padding() { return d_padding.val; }
-		/*_A_*/ DimFloat& margin() { return d_margin.val; }
-		/*_A_*/ DimFloat& spacing() { return d_spacing.val; }
-		/*_A_*/ DimPivot& pivot() { return d_pivot.val; }
-		/*_A_*/ int& zorder() { return d_zorder.val; }
-
-		StyleAttr<DimLayout> d_layout;
-		StyleAttr<Flow> d_flow;
-		StyleAttr<Space> d_space;
-		StyleAttr<Clipping> d_clipping;
-		StyleAttr<Opacity> d_opacity;
-		StyleAttr<Direction> d_direction;
-		StyleAttr<DimAlign> d_align;
-		StyleAttr<DimFloat> d_span;
-		StyleAttr<DimFloat> d_size;
-		StyleAttr<BoxFloat> d_padding;
-		StyleAttr<DimFloat> d_margin;
-		StyleAttr<DimFloat> d_spacing;
-		StyleAttr<DimPivot> d_pivot;
-		StyleAttr<int> d_zorder;
+		const Properties& properties() const { return d_properties; }
+
+		/*_A_*/ DimLayout layout() const { return d_properties.get<LAYOUT_LAYOUT>(); }
+		/*_A_*/ Flow flow() const { return d_properties.get<LAYOUT_FLOW>(); }
+		/*_A_*/ Space space() const { return d_properties.get<LAYOUT_SPACE>(); }
+		/*_A_*/ Clipping clipping() const { return d_properties.get<LAYOUT_CLIPPING>(); }
+		/*_A_*/ Opacity opacity() const { return d_properties.get<LAYOUT_OPACITY>(); }
+		/*_A_*/ Direction direction() const { return d_properties.get<LAYOUT_DIRECTION>(); }
+		/*_A_*/ DimAlign& align() { return d_properties.ref<LAYOUT_ALIGN>(); }
+		/*_A_*/ DimFloat& span() { return d_properties.ref<LAYOUT_SPAN>(); }
+		/*_A_*/ DimFloat& size() { return d_properties.ref<LAYOUT_SIZE>(); }
+		/*_A_*/ BoxFloat& padding() { return d_properties.ref<LAYOUT_PADDING>(); }
+		/*_A_*/ DimFloat& margin() { return d_properties.ref<LAYOUT_MARGIN>(); }
+		/*_A_*/ DimFloat& spacing() { return d_properties.ref<LAYOUT_SPACING>(); }
+		/*_A_*/ DimPivot& pivot() { return d_properties.ref<LAYOUT_PIVOT>(); }
+		/*_A_*/ int& zorder() { return d_properties.ref<LAYOUT_ZORDER>(); }
+
+		void setLayout(const DimLayout& layout) { d_properties.set<LAYOUT_LAYOUT>(layout); }
+		void setFlow(Flow flow) { d_properties.set<LAYOUT_FLOW>(flow); }
+		void setSpace(Space space) { d_properties.set<LAYOUT_SPACE>(space); }
+		void setClipping(Clipping clipping) { d_properties.set<LAYOUT_CLIPPING>(clipping); }
+		void setOpacity(Opacity opacity) { d_properties.set<LAYOUT_OPACITY>(opacity); }
+		void setDirection(Direction direction) { d_properties.set<LAYOUT_DIRECTION>(direction); }
+		void setAlign(const DimAlign& align) { d_properties.set<LAYOUT_ALIGN>(align); }
+		void setSpan(const DimFloat& span) { d_properties.set<LAYOUT_SPAN>(span); }
+		void setSize(const DimFloat& size) { d_properties.set<LAYOUT_SIZE>(size); }
+		void setPadding(const BoxFloat& padding) { d_properties.set<LAYOUT_PADDING>(padding); }
+		void setMargin(const DimFloat& margin) { d_properties.set<LAYOUT_MARGIN>(margin); }
+		void setSpacing(const DimFloat& spacing) { d_properties.set<LAYOUT_SPACING>(spacing); }
+		void setPivot(const DimPivot& pivot) { d_properties.set<LAYOUT_PIVOT>(pivot); }
+		void setZorder(int zorder) { d_properties.set<LAYOUT_ZORDER>(zorder); }
+
+		Properties d_properties;
 
 		_A_ _M_ size_t d_updated;
 
@@ -139,119 +210,129 @@ namespace toy
 
 	class _I_ TOY_UI_EXPORT InkStyle : public IdStruct
 	{
+	public:
+		enum Property
+		{
+			INK_EMPTY,
+			INK_BASE,
+			INK_BACKGROUND_COLOUR,
+			INK_BORDER_COLOUR,
+			INK_IMAGE_COLOUR,
+			INK_TEXT_COLOUR,
+			INK_TEXT_FONT,
+			INK_TEXT_SIZE,
+			INK_TEXT_BREAK,
+			INK_TEXT_WRAP,
+			INK_BORDER_WIDTH,
+			INK_CORNER_RADIUS,
+			INK_WEAK_CORNERS,
+			INK_PADDING,
+			INK_MARGIN,
+			INK_ALIGN,
+			INK_LINEAR_GRADIENT,
+			INK_LINEAR_GRADIENT_DIM,
+			INK_IMAGE,
+			INK_OVERLAY,
+			INK_TILE,
+			INK_IMAGE_SKIN,
+			INK_SHADOW,
+			INK_HOVER_CURSOR,
+			INK_CUSTOM_RENDERER
+		};
+
+		typedef StyleProperties<bool, Style*, Colour, Colour, Colour, Colour, string, float, bool, bool, BoxFloat, BoxFloat, bool, BoxFloat, BoxFloat, DimAlign, DimFloat, Dimension,
+								Image*, Image*, Image*, StyleShared<ImageSkin>, StyleShared<Shadow>, Type*, StyleShared<CustomRenderer>> Properties;
+
 	public:
 		_C_ InkStyle(Style* style = nullptr)
 			: IdStruct(cls())
 			, m_style(style)
-			, m_empty(true), m_base(nullptr), m_backgroundColour(Colour::Transparent), m_borderColour(Colour::Transparent), m_imageColour(Colour::Transparent), m_textColour(Colour::Transparent)
-			, m_textFont("dejavu"), m_textSize(14.f), m_textBreak(true), m_textWrap(false)
-			, m_borderWidth(0.f), m_cornerRadius(), m_weakCorners(false)
-			, m_padding(0.f), m_margin(0.f)
-			, m_align(DimAlign(LEFT, LEFT)), m_linearGradient(DimFloat(0.f, 0.f)), m_linearGradientDim(DIM_Y)
-			, m_image(nullptr), m_overlay(nullptr), m_tile(nullptr), m_hoverCursor(nullptr)
+			, m_properties(true, nullptr, Colour::Transparent, Colour::Transparent, Colour::Transparent, Colour::Transparent
+						 , "dejavu", 14.f, true, false
+						 , BoxFloat(0.f), BoxFloat(), false
+						 , BoxFloat(0.f), BoxFloat(0.f)
+						 , DimAlign(LEFT, LEFT), DimFloat(0.f, 0.f), DIM_Y
+						 , nullptr, nullptr, nullptr, StyleShared<ImageSkin>(), StyleShared<Shadow>(), nullptr, StyleShared<CustomRenderer>())
 		{}
 
 		InkStyle(const InkStyle& other)
 			: IdStruct(cls())
 			, m_style(other.m_style)
-		{
-			this->copy(other);
-		}
+			, m_properties(other.m_properties)
+		{}
 
 		InkStyle& operator=(const InkStyle&) = default;
 
 		void copy(const InkStyle& other, bool inherit)
 		{
-			if(!inherit)
-				m_base.copy(other.m_base, false);
-			if(inherit && m_base.set && other.m_style != m_base.val)
+			// the base is never inherited, and a skin with an explicit base only inherits from that base
+			if(inherit && m_properties.isSet<INK_BASE>() && other.m_style != this->base())
 				return;
 
-			m_empty.copy(other.m_empty, inherit);
-			m_backgroundColour.copy(other.m_backgroundColour, inherit);
-			m_borderColour.copy(other.m_borderColour, inherit);
-			m_imageColour.copy(other.m_imageColour, inherit);
-			m_textColour.copy(other.m_textColour, inherit);
-			m_textFont.copy(other.m_textFont, inherit);
-			m_textSize.copy(other.m_textSize, inherit);
-			m_textBreak.copy(other.m_textBreak, inherit);
-			m_textWrap.copy(other.m_textWrap, inherit);
-			m_borderWidth.copy(other.m_borderWidth, inherit);
-			m_cornerRadius.copy(other.m_cornerRadius, inherit);
-			m_weakCorners.copy(other.m_weakCorners, inherit);
-			m_padding.copy(other.m_padding, inherit);
-			m_margin.copy(other.m_margin, inherit);
-			m_align.copy(other.m_align, inherit);
-			m_linearGradient.copy(other.m_linearGradient, inherit);
-			m_linearGradientDim.copy(other.m_linearGradientDim, inherit);
-			m_image.copy(other.m_image, inherit);
-			m_overlay.copy(other.m_overlay, inherit);
-			m_tile.copy(other.m_tile, inherit);
-			m_imageSkin.copy(other.m_imageSkin, inherit);
-			m_shadow.copy(other.m_shadow, inherit);
-			m_hoverCursor.copy(other.m_hoverCursor, inherit);
-			m_customRenderer.copy(other.m_customRenderer, inherit);
+			m_properties.copy(other.m_properties, inherit, inherit ? Properties::s_all & ~(1 << INK_BASE) : Properties::s_all);
 		}
 
 		void inherit(const InkStyle& other) { return this->copy(other, true); }
 		void copy(const InkStyle& other) { return this->copy(other, false); }
 
-		void setEmpty(bool empty) { m_empty = empty; }
-
-		/*_A_*/ bool empty() const { return m_empty.val; }
-		/*_A_*/ Style* base() const { return m_base.val; }
-		/*_A_*/ Colour& backgroundColour() { return m_backgroundColour.val; }
-		/*_A_*/ Colour& borderColour() { return m_borderColour.val; }
-		/*_A_*/ Colour& imageColour() { return m_imageColour.val; }
-		/*_A_*/ Colour& textColour() { return m_textColour.val; }
-		/*_A_*/ const string& textFont() { return m_textFont.val; }
-		/*_A_*/ float& textSize() { return m_textSize.val; }
-		/*_A_*/ bool& textBreak() { return m_textBreak.val; }
-		/*_A_*/ bool& textWrap() { return m_textWrap.val; }
-		/*_A_*/ BoxFloat& borderWidth() { return m_borderWidth.val; }
-		/*_A_*/ BoxFloat& cornerRadius() { return m_cornerRadius.val; }
-		/*_A_*/ bool& weakCorners() { return m_weakCorners.val; }
-		/*_A_*/ BoxFloat& padding() { return m_padding.val; }
-		/*_A_*/ BoxFloat& margin() { return m_margin.val; }
-		/*_A_*/ DimAlign& align() { return m_align.val; }
-		/*_A_*/ DimFloat& linearGradient() { return m_linearGradient.val; }
-		/*_A_*/ Dimension& linearGradientDim() { return m_linearGradientDim.val; }
-		/*_A_*/ Image* image() { return m_image.val; }
-		/*_A_*/ Image* overlay() { return m_overlay.val; }
-		/*_A_*/ Image* tile() { return m_tile.val; }
-		/*_A_*/ ImageSkin& imageSkin() { return m_imageSkin.val; }
-		/*_A_*/ Shadow& shadow() { return m_shadow.val; }
-		/*_A_*/ Type* hoverCursor() { return m_hoverCursor.val; }
-		/*_A_*/ const CustomRenderer& customRenderer() { return m_customRenderer.val; }
+		const Properties& properties() const { return m_properties; }
+
+		/*_A_*/ bool empty() const { return m_properties.get<INK_EMPTY>(); }
+		/*_A_*/ Style* base() const { return m_properties.get<INK_BASE>(); }
+		/*_A_*/ Colour& backgroundColour() { return m_properties.ref<INK_BACKGROUND_COLOUR>(); }
+		/*_A_*/ Colour& borderColour() { return m_properties.ref<INK_BORDER_COLOUR>(); }
+		/*_A_*/ Colour& imageColour() { return m_properties.ref<INK_IMAGE_COLOUR>(); }
+		/*_A_*/ Colour& textColour() { return m_properties.ref<INK_TEXT_COLOUR>(); }
+		/*_A_*/ const string& textFont() { return m_properties.get<INK_TEXT_FONT>(); }
+		/*_A_*/ float& textSize() { return m_properties.ref<INK_TEXT_SIZE>(); }
+		/*_A_*/ bool& textBreak() { return m_properties.ref<INK_TEXT_BREAK>(); }
+		/*_A_*/ bool& textWrap() { return m_properties.ref<INK_TEXT_WRAP>(); }
+		/*_A_*/ BoxFloat& borderWidth() { return m_properties.ref<INK_BORDER_WIDTH>(); }
+		/*_A_*/ BoxFloat& cornerRadius() { return m_properties.ref<INK_CORNER_RADIUS>(); }
+		/*_A_*/ bool& weakCorners() { return m_properties.ref<INK_WEAK_CORNERS>(); }
+		/*_A_*/ BoxFloat& padding() { return m_properties.ref<INK_PADDING>(); }
+		/*_A_*/ BoxFloat& margin() { return m_properties.ref<INK_MARGIN>(); }
+		/*_A_*/ DimAlign& align() { return m_properties.ref<INK_ALIGN>(); }
+		/*_A_*/ DimFloat& linearGradient() { return m_properties.ref<INK_LINEAR_GRADIENT>(); }
+		/*_A_*/ Dimension& linearGradientDim() { return m_properties.ref<INK_LINEAR_GRADIENT_DIM>(); }
+		/*_A_*/ Image* image() { return m_properties.get<INK_IMAGE>(); }
+		/*_A_*/ Image* overlay() { return m_properties.get<INK_OVERLAY>(); }
+		/*_A_*/ Image* tile() { return m_properties.get<INK_TILE>(); }
+		/*_A_*/ const ImageSkin& imageSkin() { return m_properties.get<INK_IMAGE_SKIN>(); }
+		/*_A_*/ const Shadow& shadow() { return m_properties.get<INK_SHADOW>(); }
+		/*_A_*/ Type* hoverCursor() { return m_properties.get<INK_HOVER_CURSOR>(); }
+		/*_A_*/ const CustomRenderer& customRenderer() { return m_properties.get<INK_CUSTOM_RENDERER>(); }
+
+		void setEmpty(bool empty) { m_properties.set<INK_EMPTY>(empty); }
+		void setBase(Style* base) { m_properties.set<INK_BASE>(base); }
+		void setBackgroundColour(const Colour& colour) { m_properties.set<INK_BACKGROUND_COLOUR>(colour); }
+		void setBorderColour(const Colour& colour) { m_properties.set<INK_BORDER_COLOUR>(colour); }
+		void setImageColour(const Colour& colour) { m_properties.set<INK_IMAGE_COLOUR>(colour); }
+		void setTextColour(const Colour& colour) { m_properties.set<INK_TEXT_COLOUR>(colour); }
+		void setTextFont(const string& font) { m_properties.set<INK_TEXT_FONT>(font); }
+		void setTextSize(float size) { m_properties.set<INK_TEXT_SIZE>(size); }
+		void setTextBreak(bool textBreak) { m_properties.set<INK_TEXT_BREAK>(textBreak); }
+		void setTextWrap(bool textWrap) { m_properties.set<INK_TEXT_WRAP>(textWrap); }
+		void setBorderWidth(const BoxFloat& width) { m_properties.set<INK_BORDER_WIDTH>(width); }
+		void setCornerRadius(const BoxFloat& radius) { m_properties.set<INK_CORNER_RADIUS>(radius); }
+		void setWeakCorners(bool weakCorners) { m_properties.set<INK_WEAK_CORNERS>(weakCorners); }
+		void setPadding(const BoxFloat& padding) { m_properties.set<INK_PADDING>(padding); }
+		void setMargin(const BoxFloat& margin) { m_properties.set<INK_MARGIN>(margin); }
+		void setAlign(const DimAlign& align) { m_properties.set<INK_ALIGN>(align); }
+		void setLinearGradient(const DimFloat& gradient) { m_properties.set<INK_LINEAR_GRADIENT>(gradient); }
+		void setLinearGradientDim(Dimension dim) { m_properties.set<INK_LINEAR_GRADIENT_DIM>(dim); }
+		void setImage(Image* image) { m_properties.set<INK_IMAGE>(image); }
+		void setOverlay(Image* overlay) { m_properties.set<INK_OVERLAY>(overlay); }
+		void setTile(Image* tile) { m_properties.set<INK_TILE>(tile); }
+		void setImageSkin(const ImageSkin& imageSkin) { m_properties.set<INK_IMAGE_SKIN>(imageSkin); }
+		void setShadow(const Shadow& shadow) { m_properties.set<INK_SHADOW>(shadow); }
+		void setHoverCursor(Type* cursor) { m_properties.set<INK_HOVER_CURSOR>(cursor); }
+		void setCustomRenderer(const CustomRenderer& renderer) { m_properties.set<INK_CUSTOM_RENDERER>(renderer); }
 
 		void prepare();
 
 		Style* m_style;
-		StyleAttr<bool> m_empty;
-		StyleAttr<Style*> m_base;
-		StyleAttr<Colour> m_backgroundColour;
-		StyleAttr<Colour> m_borderColour;
-		StyleAttr<Colour> m_imageColour;
-		StyleAttr<Colour> m_textColour;
-		StyleAttr<string> m_textFont;
-		StyleAttr<float> m_textSize;
-		StyleAttr<bool> m_textBreak;
-		StyleAttr<bool> m_textWrap;
-		StyleAttr<BoxFloat> m_borderWidth;
-		StyleAttr<BoxFloat> m_cornerRadius;
-		StyleAttr<bool> m_weakCorners;
-		StyleAttr<BoxFloat> m_padding;
-		StyleAttr<BoxFloat> m_margin;
-		StyleAttr<DimAlign> m_align;
-		StyleAttr<DimFloat> m_linearGradient;
-		StyleAttr<Dimension> m_linearGradientDim;
-		StyleAttr<Image*> m_image;
-		StyleAttr<Image*> m_overlay;
-		StyleAttr<Image*> m_tile;
-		StyleAttr<ImageSkin> m_imageSkin;
-		StyleAttr<Shadow> m_shadow;
-		StyleAttr<Type*> m_hoverCursor;
-		StyleAttr<CustomRenderer> m_customRenderer;
+		Properties m_properties;
 
 		static Type& cls() { static Type ty(INDEXED); return ty; }
 	};
@@ -147,7 +147,7 @@ namespace toy
 		m_style = &m_styler.styledef(name);
 		m_style->setUpdated(m_style->updated() + 1);
 		m_skin = &m_style->skin();
-		m_style->skin().m_empty = false;
+		m_style->skin().setEmpty(false);
 	}
 
 	void StyleParser::startSubskin(const string& name)
@@ -165,7 +165,7 @@ namespace toy
 		{
 			WidgetState state = fromString<WidgetState>(strState);
 			string suffix = "_" + replaceAll(strState, "|", "_");
-			m_style->decline(state).m_image = &findImage(m_skin->image()->d_name + suffix);
+			m_style->decline(state).setImage(&findImage(m_skin->image()->d_name + suffix));
 		}
 	}
 	
@@ -177,8 +177,9 @@ namespace toy
 			WidgetState state = fromString<WidgetState>(strState);
 			string suffix = "_" + replaceAll(strState, "|", "_");
 			InkStyle& inkstyle = m_style->decline(state);
-			inkstyle.m_imageSkin = m_skin->m_imageSkin;
-			inkstyle.m_imageSkin.val.setupImage(findImage(m_skin->m_imageSkin.val.d_image->d_name + suffix));
+			ImageSkin imageSkin = m_skin->imageSkin();
+			imageSkin.setupImage(findImage(imageSkin.d_image->d_name + suffix));
+			inkstyle.setImageSkin(imageSkin);
 		}
 	}
 
@@ -190,81 +191,85 @@ namespace toy
 		if(key == "copy_skin")
 			m_style->copySkin(m_styler.styledef(value));
 		//else if(key == "inherit_skin")
-		//	m_style->skin().m_base = value;
+		//	m_style->skin().setBase(value);
 		else if(key == "reset_skin")
-			m_style->skin().m_base = nullptr;
+			m_style->skin().setBase(nullptr);
 
 		else if(key == "flow")
-			m_style->layout().d_flow = fromString<Flow>(value); // FLOW | OVERLAY | FLOAT
+			m_style->layout().setFlow(fromString<Flow>(value)); // FLOW | OVERLAY | FLOAT
 		else if(key == "clipping")
-			m_style->layout().d_clipping = fromString<Clipping>(value); // NOCLIP | CLIP
+			m_style->layout().setClipping(fromString<Clipping>(value)); // NOCLIP | CLIP
 		else if(key == "opacity")
-			m_style->layout().d_opacity = fromString<Opacity>(value); // OPAQUE | CLEAR | HOLLOW
+			m_style->layout().setOpacity(fromString<Opacity>(value)); // OPAQUE | CLEAR | HOLLOW
 		else if(key == "space")
-			m_style->layout().d_space = fromString<Space>(value); // AUTO | FLEX | BLOCK | DIV | SPACE | BOARD
+			m_style->layout().setSpace(fromString<Space>(value)); // AUTO | FLEX | BLOCK | DIV | SPACE | BOARD
 		else if(key == "direction")
-			m_style->layout().d_direction = fromString<Direction>(value); // DIM_X | DIM_Y
+			m_style->layout().setDirection(fromString<Direction>(value)); // DIM_X | DIM_Y
 		else if(key == "align")
-			m_style->layout().d_align = fromString<DimAlign>(value); // x, y
+			m_style->layout().setAlign(fromString<DimAlign>(value)); // x, y
 		else if(key == "span")
-			m_style->layout().d_span = fromString<DimFloat>(value); // 1.0, 1.0
+			m_style->layout().setSpan(fromString<DimFloat>(value)); // 1.0, 1.0
 		else if(key == "size")
-			m_style->layout().d_size = fromString<DimFloat>(value); // 123.0, 123.0
+			m_style->layout().setSize(fromString<DimFloat>(value)); // 123.0, 123.0
 		else if(key == "padding")
-			m_style->layout().d_padding = fromString<BoxFloat>(value); // left, right, top, bottom
+			m_style->layout().setPadding(fromString<BoxFloat>(value)); // left, right, top, bottom
 		else if(key == "margin")
-			m_style->layout().d_margin = fromString<DimFloat>(value); // x, y
+			m_style->layout().setMargin(fromString<DimFloat>(value)); // x, y
 		else if(key == "spacing")
-			m_style->layout().d_spacing = fromString<DimFloat>(value); // x, y
+			m_style->layout().setSpacing(fromString<DimFloat>(value)); // x, y
 		else if(key == "pivot")
-			m_style->layout().d_pivot = fromString<DimPivot>(value);// FORWARD | REVERSE
+			m_style->layout().setPivot(fromString<DimPivot>(value));// FORWARD | REVERSE
 
 		else if(key == "empty")
-			m_skin->m_empty = (value == "false" ? false : true);
+			m_skin->setEmpty((value == "false" ? false : true));
 		else if(key == "background_colour")
-			m_skin->m_backgroundColour = fromString<Colour>(value); // r, g, b, a
+			m_skin->setBackgroundColour(fromString<Colour>(value)); // r, g, b, a
 		else if(key == "border_colour")
-			m_skin->m_borderColour = fromString<Colour>(value); // r, g, b, a
+			m_skin->setBorderColour(fromString<Colour>(value)); // r, g, b, a
 		else if(key == "image_colour")
-			m_skin->m_imageColour = fromString<Colour>(value); // r, g, b, a
+			m_skin->setImageColour(fromString<Colour>(value)); // r, g, b, a
 		else if(key == "text_colour")
-			m_skin->m_textColour = fromString<Colour>(value); // r, g, b, a
+			m_skin->setTextColour(fromString<Colour>(value)); // r, g, b, a
 		else if(key == "text_size")
-			m_skin->m_textSize = fromString<float>(value); // 0.0
+			m_skin->setTextSize(fromString<float>(value)); // 0.0
 		else if(key == "text_colour")
-			m_skin->m_textFont = value; // fontname
+			m_skin->setTextFont(value); // fontname
 		else if(key == "border_width")
-			m_skin->m_borderWidth = fromString<BoxFloat>(value); // top, right, bottom, left
+			m_skin->setBorderWidth(fromString<BoxFloat>(value)); // top, right, bottom, left
 		else if(key == "corner_radius")
-			m_skin->m_cornerRadius = fromString<BoxFloat>(value); // topleft, topright, bottomright, bottomleft
+			m_skin->setCornerRadius(fromString<BoxFloat>(value)); // topleft, topright, bottomright, bottomleft
 		else if(key == "weak_corners")
-			m_skin->m_weakCorners = (value == "false" ? false : true); // true | false
+			m_skin->setWeakCorners((value == "false" ? false : true)); // true | false
 		else if(key == "skin_align")
-			m_skin->m_align = fromString<DimAlign>(value); // x, y
+			m_skin->setAlign(fromString<DimAlign>(value)); // x, y
 		else if(key == "skin_padding")
-			m_skin->m_padding = fromString<BoxFloat>(value); // left, right, top, bottom
+			m_skin->setPadding(fromString<BoxFloat>(value)); // left, right, top, bottom
 		else if(key == "skin_margin")
-			m_skin->m_margin = fromString<BoxFloat>(value); // x, y, z, w
+			m_skin->setMargin(fromString<BoxFloat>(value)); // x, y, z, w
 		else if(key == "topdown_gradient")
-			m_skin->m_linearGradient = fromString<DimFloat>(value); // top, down
+			m_skin->setLinearGradient(fromString<DimFloat>(value)); // top, down
 		else if(key == "image")
-			m_skin->m_image = value == "null" ? nullptr : &findImage(value); // image.png
+			m_skin->setImage(value == "null" ? nullptr : &findImage(value)); // image.png
 		else if(key == "overlay")
-			m_skin->m_overlay = value == "null" ? nullptr : &findImage(value); // image.png
+			m_skin->setOverlay(value == "null" ? nullptr : &findImage(value)); // image.png
 		else if(key == "tile")
-			m_skin->m_tile = value == "null" ? nullptr : &findImage(value); // image.png
+			m_skin->setTile(value == "null" ? nullptr : &findImage(value)); // image.png
 		else if(key == "image_skin")
-			m_skin->m_imageSkin = ImageSkin(values[0],	fromString<int>(values[1]), fromString<int>(values[2]),
+			m_skin->setImageSkin(ImageSkin(values[0],	fromString<int>(values[1]), fromString<int>(values[2]),
 														fromString<int>(values[3]), fromString<int>(values[4]),
 														values.size() > 5 ? fromString<int>(values[5]) : 0,
-														values.size() > 6 ? fromString<Dimension>(values[6]) : DIM_NULL); // : image.png
+														values.size() > 6 ? fromString<Dimension>(values[6]) : DIM_NULL)); // : image.png
 		else if(key == "shadow")
-			m_skin->m_shadow = Shadow(	fromString<float>(values[0]), fromString<float>(values[1]),
-										fromString<float>(values[2]), fromString<float>(values[3])); // : xoffset, yoffset, blur, spread
+			m_skin->setShadow(Shadow(	fromString<float>(values[0]), fromString<float>(values[1]),
+										fromString<float>(values[2]), fromString<float>(values[3]))); // : xoffset, yoffset, blur, spread
 		else if(key == "no_shadow")
-			m_skin->m_shadow = Shadow();
+			m_skin->setShadow(Shadow());
 		else if(key == "shadow_colour")
-			m_skin->m_shadow.val.d_colour = fromString<Colour>(value);
+		{
+			Shadow shadow = m_skin->shadow();
+			shadow.d_colour = fromString<Colour>(value);
+			m_skin->setShadow(shadow);
+		}
 		else if(key == "decline_image")
 			this->declineImage(value);
 		else if(key == "decline_image_skin")
@@ -0,0 +1,99 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/UiArena.h>
+
+/* std */
+#include <new>
+#include <cstdint>
+
+namespace toy
+{
+	bool UiArena::s_heap = false;
+
+	UiArena::UiArena(size_t chunkSize)
+		: m_chunkSize(chunkSize)
+		, m_chunks()
+		, m_cursor(nullptr)
+		, m_remaining(0)
+		, m_liveBlocks(0)
+	{
+		for(size_t i = 0; i < s_numClasses; ++i)
+			m_freeLists[i] = nullptr;
+	}
+
+	UiArena::~UiArena()
+	{
+#if 0 // DEBUG
+		if(m_liveBlocks > 0)
+			printf("WARNING: UiArena destroyed with %zu live blocks\n", m_liveBlocks);
+#endif
+	}
+
+	void* UiArena::allocate(size_t size)
+	{
+		size_t sizeClass = (size + sizeof(Header) + s_granularity - 1) / s_granularity;
+		if(sizeClass >= s_numClasses)
+			return allocate(nullptr, size);
+
+		Header* header;
+		if(m_freeLists[sizeClass])
+		{
+			header = reinterpret_cast<Header*>(m_freeLists[sizeClass]);
+			m_freeLists[sizeClass] = m_freeLists[sizeClass]->d_next;
+		}
+		else
+		{
+			size_t blockSize = sizeClass * s_granularity;
+			if(m_remaining < blockSize)
+			{
+				m_chunks.emplace_back(new char[m_chunkSize + s_granularity]);
+				char* start = m_chunks.back().get();
+				m_cursor = start + (s_granularity - reinterpret_cast<uintptr_t>(start) % s_granularity) % s_granularity;
+				m_remaining = m_chunkSize;
+			}
+
+			header = reinterpret_cast<Header*>(m_cursor);
+			m_cursor += blockSize;
+			m_remaining -= blockSize;
+		}
+
+		header->d_arena = this;
+		header->d_sizeClass = sizeClass;
+		++m_liveBlocks;
+		return header + 1;
+	}
+
+	void UiArena::release(void* block, size_t sizeClass)
+	{
+		FreeBlock* free = static_cast<FreeBlock*>(block);
+		free->d_next = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = free;
+		--m_liveBlocks;
+	}
+
+	void* UiArena::allocate(UiArena* arena, size_t size)
+	{
+		if(arena && !s_heap)
+			return arena->allocate(size);
+
+		Header* header = static_cast<Header*>(::operator new(size + sizeof(Header)));
+		header->d_arena = nullptr;
+		header->d_sizeClass = 0;
+		return header + 1;
+	}
+
+	void UiArena::deallocate(void* pointer)
+	{
+		if(!pointer)
+			return;
+
+		Header* header = static_cast<Header*>(pointer) - 1;
+		if(header->d_arena)
+			header->d_arena->release(header, header->d_sizeClass);
+		else
+			::operator delete(header);
+	}
+}
@@ -0,0 +1,73 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_UIARENA_H
+#define TOY_UIARENA_H
+
+/* toy */
+#include <toyui/Forward.h>
+#include <toyobj/Util/NonCopy.h>
+
+/* std */
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace toy
+{
+	/* Chunked allocator with one free list per size class
+	 * Every block is prefixed with a header pointing to its arena, so that a plain delete finds its way back
+	 * Blocks allocated without an arena, or too large for a size class, go to the global heap with the same header
+	 */
+	class TOY_UI_EXPORT UiArena : public NonCopy
+	{
+	public:
+		UiArena(size_t chunkSize = 256 * 1024);
+		~UiArena();
+
+		size_t liveBlocks() { return m_liveBlocks; }
+		size_t numChunks() { return m_chunks.size(); }
+
+		void* allocate(size_t size);
+		void release(void* block, size_t sizeClass);
+
+		static void* allocate(UiArena* arena, size_t size);
+		static void deallocate(void* pointer);
+
+		static const size_t s_granularity = 16;
+		static const size_t s_numClasses = 64;
+
+		// sends every allocation to the global heap, to compare the arena against it
+		static bool s_heap;
+
+	protected:
+		struct alignas(16) Header
+		{
+			UiArena* d_arena;
+			size_t d_sizeClass;
+		};
+
+		struct FreeBlock
+		{
+			FreeBlock* d_next;
+		};
+
+		size_t m_chunkSize;
+		std::vector<std::unique_ptr<char[]>> m_chunks;
+		char* m_cursor;
+		size_t m_remaining;
+
+		FreeBlock* m_freeLists[s_numClasses];
+		size_t m_liveBlocks;
+	};
+
+	/* Class level allocation operators routing through a UiArena : new (arena) T(...) constructs into the arena */
+#define TOY_UI_ARENA_ALLOCATED \
+		static void* operator new(size_t size) { return UiArena::allocate(nullptr, size); } \
+		static void* operator new(size_t size, UiArena* arena) { return UiArena::allocate(arena, size); } \
+		static void operator delete(void* pointer) { UiArena::deallocate(pointer); } \
+		static void operator delete(void* pointer, UiArena* arena) { UNUSED(arena); UiArena::deallocate(pointer); }
+}
+
+#endif // TOY_UIARENA_H
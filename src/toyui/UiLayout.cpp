@@ -75,117 +75,117 @@ namespace toy
 
 	void Styler::defaultLayout()
 	{
-		this->styledef(RootSheet::cls()).layout().d_space = BOARD;
-		this->styledef(RootSheet::cls()).layout().d_clipping = CLIP;
-		this->styledef(RootSheet::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(RootSheet::cls()).layout().setSpace(BOARD);
+		this->styledef(RootSheet::cls()).layout().setClipping(CLIP);
+		this->styledef(RootSheet::cls()).layout().setOpacity(OPAQUE);
 
-		this->styledef(Cursor::cls()).layout().d_zorder = -1;
-		this->styledef(Tooltip::cls()).layout().d_zorder = -2;
+		this->styledef(Cursor::cls()).layout().setZorder(-1);
+		this->styledef(Tooltip::cls()).layout().setZorder(-2);
 
 		// LAYOUT
-		this->styledef(Board::cls()).layout().d_space = BOARD;
-		this->styledef(Board::cls()).layout().d_direction = READING;
-		this->styledef(Board::cls()).layout().d_clipping = CLIP;
-		this->styledef(Tab::cls()).layout().d_clipping = CLIP;
+		this->styledef(Board::cls()).layout().setSpace(BOARD);
+		this->styledef(Board::cls()).layout().setDirection(READING);
+		this->styledef(Board::cls()).layout().setClipping(CLIP);
+		this->styledef(Tab::cls()).layout().setClipping(CLIP);
 
-		this->styledef(Layout::cls()).layout().d_direction = PARAGRAPH;
+		this->styledef(Layout::cls()).layout().setDirection(PARAGRAPH);
 
-		this->styledef(GridSheet::cls()).layout().d_opacity = OPAQUE;
-		this->styledef(GridSubdiv::cls()).layout().d_space = BOARD;
+		this->styledef(GridSheet::cls()).layout().setOpacity(OPAQUE);
+		this->styledef(GridSubdiv::cls()).layout().setSpace(BOARD);
 
 		// SHEET
-		this->styledef(Sheet::cls()).layout().d_space = SHEET;
+		this->styledef(Sheet::cls()).layout().setSpace(SHEET);
 
 		// OVERLAYS
-		this->styledef(Decal::cls()).layout().d_flow = FREE;
-		this->styledef(Decal::cls()).layout().d_space = ITEM;
+		this->styledef(Decal::cls()).layout().setFlow(FREE);
+		this->styledef(Decal::cls()).layout().setSpace(ITEM);
 
-		this->styledef(Overlay::cls()).layout().d_flow = FREE;
-		this->styledef(Overlay::cls()).layout().d_space = BLOCK;
-		this->styledef(Overlay::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(Overlay::cls()).layout().setFlow(FREE);
+		this->styledef(Overlay::cls()).layout().setSpace(BLOCK);
+		this->styledef(Overlay::cls()).layout().setOpacity(OPAQUE);
 
-		this->styledef(Node::cls()).layout().d_direction = READING;
+		this->styledef(Node::cls()).layout().setDirection(READING);
 
 		// LAYERS
-		this->styledef(SliderDisplay::cls()).layout().d_flow = OVERLAY;
-		this->styledef(SliderKnob::cls()).layout().d_flow = OVERLAY;
+		this->styledef(SliderDisplay::cls()).layout().setFlow(OVERLAY);
+		this->styledef(SliderKnob::cls()).layout().setFlow(OVERLAY);
 
-		this->styledef(ScrollerKnob::cls()).layout().d_flow = FLOW;
+		this->styledef(ScrollerKnob::cls()).layout().setFlow(FLOW);
 
 		// CONTAINERS
-		this->styledef(Container::cls()).layout().d_space = SHEET;
+		this->styledef(Container::cls()).layout().setSpace(SHEET);
 
-		this->styledef(ScrollSheet::cls()).layout().d_opacity = OPAQUE;
-		this->styledef(ScrollPlan::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(ScrollSheet::cls()).layout().setOpacity(OPAQUE);
+		this->styledef(ScrollPlan::cls()).layout().setOpacity(OPAQUE);
 
-		this->styledef(Window::cls()).layout().d_space = FIXED_BLOCK;
+		this->styledef(Window::cls()).layout().setSpace(FIXED_BLOCK);
 
-		this->styledef(Dockbox::cls()).layout().d_space = SHEET;
-		this->styledef(DockWindow::cls()).layout().d_flow = FLOW;
-		this->styledef(DockWindow::cls()).layout().d_space = SHEET;
+		this->styledef(Dockbox::cls()).layout().setSpace(SHEET);
+		this->styledef(DockWindow::cls()).layout().setFlow(FLOW);
+		this->styledef(DockWindow::cls()).layout().setSpace(SHEET);
 
 		// BLOCKS
-		this->styledef(WrapWindow::cls()).layout().d_space = BLOCK;
+		this->styledef(WrapWindow::cls()).layout().setSpace(BLOCK);
 
 		// SPACER
-		this->styledef(Spacer::cls()).layout().d_space = SPACE;
+		this->styledef(Spacer::cls()).layout().setSpace(SPACE);
 
-		this->styledef(Scroller::cls()).layout().d_space = PARALLEL_FLEX;
+		this->styledef(Scroller::cls()).layout().setSpace(PARALLEL_FLEX);
 
-		this->styledef(Filler::cls()).layout().d_space = SHEET;
-		this->styledef(Slider::cls()).layout().d_space = SHEET;
+		this->styledef(Filler::cls()).layout().setSpace(SHEET);
+		this->styledef(Slider::cls()).layout().setSpace(SHEET);
 
-		this->styledef(SliderKnob::cls()).layout().d_space = SHEET;
+		this->styledef(SliderKnob::cls()).layout().setSpace(SHEET);
 
 		// LINE
-		this->styledef(Line::cls()).layout().d_space = LINE;
+		this->styledef(Line::cls()).layout().setSpace(LINE);
 
 		// ALIGNED
-		this->styledef(DropdownList::cls()).layout().d_flow = ALIGN;
-		this->styledef(DropdownList::cls()).layout().d_align = DimAlign(LEFT, OUT_RIGHT);
-		this->styledef(MenuList::cls()).layout().d_align = DimAlign(LEFT, OUT_RIGHT);
-		this->styledef(SubMenuList::cls()).layout().d_align = DimAlign(OUT_RIGHT, LEFT);
+		this->styledef(DropdownList::cls()).layout().setFlow(ALIGN);
+		this->styledef(DropdownList::cls()).layout().setAlign(DimAlign(LEFT, OUT_RIGHT));
+		this->styledef(MenuList::cls()).layout().setAlign(DimAlign(LEFT, OUT_RIGHT));
+		this->styledef(SubMenuList::cls()).layout().setAlign(DimAlign(OUT_RIGHT, LEFT));
 
 		// DIVS
-		this->styledef(Div::cls()).layout().d_space = DIV;
-		this->styledef(TableHead::cls()).layout().d_space = DIV;
-		this->styledef(Text::cls()).layout().d_space = DIV;
+		this->styledef(Div::cls()).layout().setSpace(DIV);
+		this->styledef(TableHead::cls()).layout().setSpace(DIV);
+		this->styledef(Text::cls()).layout().setSpace(DIV);
 		
-		this->styledef(Docker::cls()).layout().d_space = SPACE;
+		this->styledef(Docker::cls()).layout().setSpace(SPACE);
 
 		// STACKS
-		this->styledef(Stack::cls()).layout().d_space = STACK;
-		this->styledef(Text::cls()).layout().d_space = STACK;
+		this->styledef(Stack::cls()).layout().setSpace(STACK);
+		this->styledef(Text::cls()).layout().setSpace(STACK);
 
 		// CONTROLS
-		this->styledef(Item::cls()).layout().d_space = ITEM;
-		this->styledef(Input<bool>::cls()).layout().d_space = ITEM;
-		this->styledef(Control::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(Item::cls()).layout().setSpace(ITEM);
+		this->styledef(Input<bool>::cls()).layout().setSpace(ITEM);
+		this->styledef(Control::cls()).layout().setOpacity(OPAQUE);
 		
-		this->styledef(WrapControl::cls()).layout().d_space = LINE;
-		this->styledef(WrapControl::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(WrapControl::cls()).layout().setSpace(LINE);
+		this->styledef(WrapControl::cls()).layout().setOpacity(OPAQUE);
 
-		this->styledef(WrapControl::cls()).layout().d_space = LINE;
-		this->styledef(TypeIn::cls()).layout().d_space = LINE;
+		this->styledef(WrapControl::cls()).layout().setSpace(LINE);
+		this->styledef(TypeIn::cls()).layout().setSpace(LINE);
 		
-		this->styledef(ColumnHeader::cls()).layout().d_space = LINE;
+		this->styledef(ColumnHeader::cls()).layout().setSpace(LINE);
 
-		this->styledef(Menu::cls()).layout().d_space = ITEM;
+		this->styledef(Menu::cls()).layout().setSpace(ITEM);
 
 		// EDITORS
-		this->styledef(Textbox::cls()).layout().d_space = BOARD;
+		this->styledef(Textbox::cls()).layout().setSpace(BOARD);
 
-		this->styledef(Canvas::cls()).layout().d_space = BOARD;
-		this->styledef(Canvas::cls()).layout().d_opacity = OPAQUE;
-		this->styledef(Canvas::cls()).layout().d_clipping = CLIP;
+		this->styledef(Canvas::cls()).layout().setSpace(BOARD);
+		this->styledef(Canvas::cls()).layout().setOpacity(OPAQUE);
+		this->styledef(Canvas::cls()).layout().setClipping(CLIP);
 
-		this->styledef(Plan::cls()).layout().d_space = MANUAL_SPACE;
+		this->styledef(Plan::cls()).layout().setSpace(MANUAL_SPACE);
 
-		this->styledef(Plan::cls()).skin().m_customRenderer = &drawGrid;
+		this->styledef(Plan::cls()).skin().setCustomRenderer(&drawGrid);
 
-		this->styledef(Toolbar::cls()).layout().d_space = ITEM;
+		this->styledef(Toolbar::cls()).layout().setSpace(ITEM);
 
-		this->styledef(Dockspace::cls()).layout().d_opacity = OPAQUE;
+		this->styledef(Dockspace::cls()).layout().setOpacity(OPAQUE);
 
 		// GEOMETRY
 
@@ -194,120 +194,120 @@ namespace toy
 		//
 		// 
 
-		this->styledef(WindowSizerLeft::cls()).layout().d_space = SHEET;
-		this->styledef(WindowSizerRight::cls()).layout().d_space = SHEET;
+		this->styledef(WindowSizerLeft::cls()).layout().setSpace(SHEET);
+		this->styledef(WindowSizerRight::cls()).layout().setSpace(SHEET);
 
-		this->styledef(NoScrollZone::cls()).layout().d_space = SHEET;
+		this->styledef(NoScrollZone::cls()).layout().setSpace(SHEET);
 
-		this->styledef(Slider::cls()).layout().d_direction = DIMENSION;
-		this->styledef(Scrollbar::cls()).layout().d_direction = DIMENSION;
-		this->styledef(Dockline::cls()).layout().d_direction = DIMENSION;
-		this->styledef(GridSubdiv::cls()).layout().d_direction = DIMENSION;
+		this->styledef(Slider::cls()).layout().setDirection(DIMENSION);
+		this->styledef(Scrollbar::cls()).layout().setDirection(DIMENSION);
+		this->styledef(Dockline::cls()).layout().setDirection(DIMENSION);
+		this->styledef(GridSubdiv::cls()).layout().setDirection(DIMENSION);
 
-		this->styledef(GridLine::cls()).layout().d_space = SHEET;
-		this->styledef(GridLine::cls()).layout().d_direction = READING;
+		this->styledef(GridLine::cls()).layout().setSpace(SHEET);
+		this->styledef(GridLine::cls()).layout().setDirection(READING);
 
-		this->styledef(GridColumn::cls()).layout().d_space = SHEET;
-		this->styledef(GridColumn::cls()).layout().d_layout = DimLayout(AUTO_LAYOUT, NO_LAYOUT);
+		this->styledef(GridColumn::cls()).layout().setSpace(SHEET);
+		this->styledef(GridColumn::cls()).layout().setLayout(DimLayout(AUTO_LAYOUT, NO_LAYOUT));
 
-		this->styledef(GridOverlay::cls()).layout().d_space = BOARD;
-		this->styledef(GridOverlay::cls()).layout().d_flow = OVERLAY;
-		this->styledef(GridOverlay::cls()).layout().d_direction = READING;
-		this->styledef(GridOverlay::cls()).layout().d_opacity = HOLLOW;
+		this->styledef(GridOverlay::cls()).layout().setSpace(BOARD);
+		this->styledef(GridOverlay::cls()).layout().setFlow(OVERLAY);
+		this->styledef(GridOverlay::cls()).layout().setDirection(READING);
+		this->styledef(GridOverlay::cls()).layout().setOpacity(HOLLOW);
 
-		this->styledef(Dockbar::cls()).layout().d_align = DimAlign(RIGHT, RIGHT);
+		this->styledef(Dockbar::cls()).layout().setAlign(DimAlign(RIGHT, RIGHT));
 
-		this->styledef(Docker::cls()).layout().d_flow = ALIGN;
-		this->styledef(Docker::cls()).layout().d_align = DimAlign(LEFT, OUT_LEFT);
+		this->styledef(Docker::cls()).layout().setFlow(ALIGN);
+		this->styledef(Docker::cls()).layout().setAlign(DimAlign(LEFT, OUT_LEFT));
 
-		this->styledef(Popup::cls()).layout().d_size = DimFloat(280.f, 350.f);
+		this->styledef(Popup::cls()).layout().setSize(DimFloat(280.f, 350.f));
 
-		this->styledef(Dockbox::cls()).layout().d_flow = FLOW;
-		this->styledef(Dockbox::cls()).layout().d_size = DimFloat(300.f, 0.f);
-		//this->styledef(Dockbox::cls()).skin().m_base = &this->style(DockWindow::cls());
+		this->styledef(Dockbox::cls()).layout().setFlow(FLOW);
+		this->styledef(Dockbox::cls()).layout().setSize(DimFloat(300.f, 0.f));
+		//this->styledef(Dockbox::cls()).skin().setBase(&this->style(DockWindow::cls()));
 		// this initializes Window before the styledef is set
 
 
-		this->styledef(ScrollZone::cls()).layout().d_layout = DimLayout(AUTO_SIZE, AUTO_SIZE);
-		this->styledef(ScrollZone::cls()).layout().d_clipping = CLIP;
+		this->styledef(ScrollZone::cls()).layout().setLayout(DimLayout(AUTO_SIZE, AUTO_SIZE));
+		this->styledef(ScrollZone::cls()).layout().setClipping(CLIP);
 
 
 
-		this->styledef(Button::cls()).layout().d_align = DimAlign(LEFT, CENTER);
-		this->styledef(CloseButton::cls()).layout().d_align = DimAlign(RIGHT, CENTER);
+		this->styledef(Button::cls()).layout().setAlign(DimAlign(LEFT, CENTER));
+		this->styledef(CloseButton::cls()).layout().setAlign(DimAlign(RIGHT, CENTER));
 
 
 
 
 
 
-		this->styledef(NodeConnectionProxy::cls()).layout().d_size = DimFloat(10.f, 10.f);
+		this->styledef(NodeConnectionProxy::cls()).layout().setSize(DimFloat(10.f, 10.f));
 
-		this->styledef(Header::cls()).layout().d_padding = BoxFloat(6.f);
+		this->styledef(Header::cls()).layout().setPadding(BoxFloat(6.f));
 
-		this->styledef(WrapButton::cls()).layout().d_spacing = DimFloat(2.f);
+		this->styledef(WrapButton::cls()).layout().setSpacing(DimFloat(2.f));
 
-		this->styledef(Dockbar::cls()).layout().d_padding = BoxFloat(4.f);
-		this->styledef(Dockbar::cls()).layout().d_spacing = DimFloat(4.f);
+		this->styledef(Dockbar::cls()).layout().setPadding(BoxFloat(4.f));
+		this->styledef(Dockbar::cls()).layout().setSpacing(DimFloat(4.f));
 
-		this->styledef(Page::cls()).layout().d_spacing = DimFloat(6.f);
+		this->styledef(Page::cls()).layout().setSpacing(DimFloat(6.f));
 
-		this->styledef(Dialog::cls()).layout().d_padding = BoxFloat(25.f, 12.f, 25.f, 12.f);
-		this->styledef(Dialog::cls()).layout().d_spacing = DimFloat(6.f);
+		this->styledef(Dialog::cls()).layout().setPadding(BoxFloat(25.f, 12.f, 25.f, 12.f));
+		this->styledef(Dialog::cls()).layout().setSpacing(DimFloat(6.f));
 
-		this->styledef(Toolbar::cls()).layout().d_padding = BoxFloat(6.f);
-		this->styledef(Toolbar::cls()).layout().d_spacing = DimFloat(6.f);
-		this->styledef(Menubar::cls()).layout().d_spacing = DimFloat(6.f);
+		this->styledef(Toolbar::cls()).layout().setPadding(BoxFloat(6.f));
+		this->styledef(Toolbar::cls()).layout().setSpacing(DimFloat(6.f));
+		this->styledef(Menubar::cls()).layout().setSpacing(DimFloat(6.f));
 
-		this->styledef(GridSheet::cls()).layout().d_spacing = DimFloat(5.f);
+		this->styledef(GridSheet::cls()).layout().setSpacing(DimFloat(5.f));
 
-		this->styledef(Tab::cls()).layout().d_padding = BoxFloat(6.f);
-		this->styledef(DockTab::cls()).layout().d_padding = BoxFloat(0.f);
+		this->styledef(Tab::cls()).layout().setPadding(BoxFloat(6.f));
+		this->styledef(DockTab::cls()).layout().setPadding(BoxFloat(0.f));
 
-		this->styledef(GridSubdiv::cls()).layout().d_spacing = DimFloat(6.f);
-		this->styledef(Dockspace::cls()).layout().d_spacing = DimFloat(6.f);
+		this->styledef(GridSubdiv::cls()).layout().setSpacing(DimFloat(6.f));
+		this->styledef(Dockspace::cls()).layout().setSpacing(DimFloat(6.f));
 
-		this->styledef(ExpandboxBody::cls()).layout().d_padding = BoxFloat(12.f, 2.f, 0.f, 2.f);
-		this->styledef(ExpandboxBody::cls()).layout().d_spacing = DimFloat(6.f);
+		this->styledef(ExpandboxBody::cls()).layout().setPadding(BoxFloat(12.f, 2.f, 0.f, 2.f));
+		this->styledef(ExpandboxBody::cls()).layout().setSpacing(DimFloat(6.f));
 
-		this->styledef(TreeNodeBody::cls()).layout().d_padding = BoxFloat(24.f, 2.f, 0.f, 2.f);
+		this->styledef(TreeNodeBody::cls()).layout().setPadding(BoxFloat(24.f, 2.f, 0.f, 2.f));
 
-		this->styledef(Table::cls()).layout().d_spacing = DimFloat(0.f, 2.f);
+		this->styledef(Table::cls()).layout().setSpacing(DimFloat(0.f, 2.f));
 
-		this->styledef(WindowHeader::cls()).skin().m_hoverCursor = &MoveCursor::cls();
-		this->styledef(Dockspace::cls()).skin().m_hoverCursor = &ResizeCursorX::cls();
-		this->styledef(WindowSizerLeft::cls()).skin().m_hoverCursor = &ResizeCursorDiagLeft::cls();
-		this->styledef(WindowSizerRight::cls()).skin().m_hoverCursor = &ResizeCursorDiagRight::cls();
+		this->styledef(WindowHeader::cls()).skin().setHoverCursor(&MoveCursor::cls());
+		this->styledef(Dockspace::cls()).skin().setHoverCursor(&ResizeCursorX::cls());
+		this->styledef(WindowSizerLeft::cls()).skin().setHoverCursor(&ResizeCursorDiagLeft::cls());
+		this->styledef(WindowSizerRight::cls()).skin().setHoverCursor(&ResizeCursorDiagRight::cls());
 
-		this->styledef(Cursor::cls()).skin().m_image = &findImage("mousepointer");
+		this->styledef(Cursor::cls()).skin().setImage(&findImage("mousepointer"));
 
-		this->styledef(ResizeCursorX::cls()).skin().m_image = &findImage("resize_h_20");
-		this->styledef(ResizeCursorX::cls()).skin().m_padding = BoxFloat(-10.f, -10.f, +10.f, +10.f);
-		this->styledef(ResizeCursorY::cls()).skin().m_image = &findImage("resize_v_20");
-		this->styledef(ResizeCursorY::cls()).skin().m_padding = BoxFloat(-10.f, -10.f, +10.f, +10.f);
-		this->styledef(MoveCursor::cls()).skin().m_image = &findImage("move_20");
-		this->styledef(MoveCursor::cls()).skin().m_padding = BoxFloat(-10.f, -10.f, +10.f, +10.f);
-		this->styledef(ResizeCursorDiagLeft::cls()).skin().m_image = &findImage("resize_diag_left_20");
-		this->styledef(ResizeCursorDiagLeft::cls()).skin().m_padding = BoxFloat(-10.f, -10.f, +10.f, +10.f);
-		this->styledef(ResizeCursorDiagRight::cls()).skin().m_image = &findImage("resize_diag_right_20");
-		this->styledef(ResizeCursorDiagRight::cls()).skin().m_padding = BoxFloat(-10.f, -10.f, +10.f, +10.f);
-		this->styledef(CaretCursor::cls()).skin().m_image = &findImage("caret_white");
-		this->styledef(CaretCursor::cls()).skin().m_padding = BoxFloat(-4.f, -9.f, +4.f, +9.f);
+		this->styledef(ResizeCursorX::cls()).skin().setImage(&findImage("resize_h_20"));
+		this->styledef(ResizeCursorX::cls()).skin().setPadding(BoxFloat(-10.f, -10.f, +10.f, +10.f));
+		this->styledef(ResizeCursorY::cls()).skin().setImage(&findImage("resize_v_20"));
+		this->styledef(ResizeCursorY::cls()).skin().setPadding(BoxFloat(-10.f, -10.f, +10.f, +10.f));
+		this->styledef(MoveCursor::cls()).skin().setImage(&findImage("move_20"));
+		this->styledef(MoveCursor::cls()).skin().setPadding(BoxFloat(-10.f, -10.f, +10.f, +10.f));
+		this->styledef(ResizeCursorDiagLeft::cls()).skin().setImage(&findImage("resize_diag_left_20"));
+		this->styledef(ResizeCursorDiagLeft::cls()).skin().setPadding(BoxFloat(-10.f, -10.f, +10.f, +10.f));
+		this->styledef(ResizeCursorDiagRight::cls()).skin().setImage(&findImage("resize_diag_right_20"));
+		this->styledef(ResizeCursorDiagRight::cls()).skin().setPadding(BoxFloat(-10.f, -10.f, +10.f, +10.f));
+		this->styledef(CaretCursor::cls()).skin().setImage(&findImage("caret_white"));
+		this->styledef(CaretCursor::cls()).skin().setPadding(BoxFloat(-4.f, -9.f, +4.f, +9.f));
 
-		this->styledef(ToolbarMover::cls()).skin().m_image = &findImage("mousepointer");
+		this->styledef(ToolbarMover::cls()).skin().setImage(&findImage("mousepointer"));
 
-		this->styledef(Text::cls()).skin().m_textWrap = true;
-		this->styledef(Textbox::cls()).skin().m_textWrap = true;
+		this->styledef(Text::cls()).skin().setTextWrap(true);
+		this->styledef(Textbox::cls()).skin().setTextWrap(true);
 
-		this->styledef(Label::cls()).skin().m_textColour = Colour::White;
-		this->styledef(Label::cls()).skin().m_padding = BoxFloat(2.f);
+		this->styledef(Label::cls()).skin().setTextColour(Colour::White);
+		this->styledef(Label::cls()).skin().setPadding(BoxFloat(2.f));
 
-		this->styledef(Icon::cls()).skin().m_padding = BoxFloat(3.f);
-		this->styledef(Icon::cls()).skin().m_empty = false;
+		this->styledef(Icon::cls()).skin().setPadding(BoxFloat(3.f));
+		this->styledef(Icon::cls()).skin().setEmpty(false);
 
-		this->styledef(Plan::cls()).skin().m_borderWidth = BoxFloat(2.f);
-		this->styledef(Plan::cls()).skin().m_borderColour = Colour::AlphaGrey;
+		this->styledef(Plan::cls()).skin().setBorderWidth(BoxFloat(2.f));
+		this->styledef(Plan::cls()).skin().setBorderColour(Colour::AlphaGrey);
 
-		this->styledef(Placeholder::cls()).skin().m_backgroundColour = Colour::Blue;
+		this->styledef(Placeholder::cls()).skin().setBackgroundColour(Colour::Blue);
 	}
 }
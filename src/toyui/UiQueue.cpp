@@ -0,0 +1,187 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#include <toyui/Config.h>
+#include <toyui/UiQueue.h>
+
+#include <toyui/Widget/Widget.h>
+
+/* std */
+#include <chrono>
+#include <algorithm>
+
+namespace toy
+{
+	typedef std::chrono::duration<float, std::milli> Milliseconds;
+
+	std::thread::id UiQueue::s_uiThread;
+
+	UiQueue::UiQueue()
+		: m_head(nullptr)
+		, m_notify()
+		, m_budget(4.f)
+		, m_pending()
+		, m_slots()
+		, m_generations()
+		, m_lastGeneration(0)
+		, m_coalesced(0)
+	{}
+
+	UiQueue::~UiQueue()
+	{
+		this->collect();
+		for(Node* node : m_pending)
+			delete node;
+	}
+
+	void UiQueue::setUiThread()
+	{
+		if(s_uiThread == std::thread::id())
+			s_uiThread = std::this_thread::get_id();
+	}
+
+	bool UiQueue::onUiThread()
+	{
+		// before any window exists, widgets can be built from anywhere
+		return s_uiThread == std::thread::id() || s_uiThread == std::this_thread::get_id();
+	}
+
+	UiTarget UiQueue::target(Widget& widget)
+	{
+		TOY_ASSERT_UI_THREAD();
+		size_t& generation = m_generations[&widget];
+		if(!generation)
+			generation = ++m_lastGeneration;
+		return { &widget, generation };
+	}
+
+	void UiQueue::post(const Command& command)
+	{
+		this->push(new Node{ nullptr, nullptr, 0, 0, command });
+	}
+
+	void UiQueue::post(const UiTarget& target, size_t slot, const Command& command)
+	{
+		this->push(new Node{ nullptr, target.d_widget, target.d_generation, slot, command });
+	}
+
+	void UiQueue::postLabel(const UiTarget& target, const string& label)
+	{
+		Widget* widget = target.d_widget;
+		this->post(target, UPDATE_LABEL, [widget, label] { widget->setLabel(label); });
+	}
+
+	void UiQueue::postVisible(const UiTarget& target, bool visible)
+	{
+		Widget* widget = target.d_widget;
+		this->post(target, UPDATE_VISIBLE, [widget, visible] { if(visible) widget->show(); else widget->hide(); });
+	}
+
+	void UiQueue::push(Node* node)
+	{
+		Node* head = m_head.load(std::memory_order_relaxed);
+		do
+			node->d_next = head;
+		while(!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+		if(m_notify && !onUiThread())
+			m_notify();
+	}
+
+	void UiQueue::collect()
+	{
+		// the producers push on the head : the list comes out in reverse posting order
+		Node* list = m_head.exchange(nullptr, std::memory_order_acquire);
+		Node* ordered = nullptr;
+		while(list)
+		{
+			Node* next = list->d_next;
+			list->d_next = ordered;
+			ordered = list;
+			list = next;
+		}
+
+		while(ordered)
+		{
+			Node* node = ordered;
+			ordered = ordered->d_next;
+
+			if(!node->d_target)
+			{
+				m_pending.push_back(node);
+				continue;
+			}
+
+			// posted after the widget was dropped, it might not exist anymore
+			if(!this->alive(*node))
+			{
+				delete node;
+				continue;
+			}
+
+			// the pending update keeps its place in the queue and takes the latest command
+			Node*& slot = m_slots[std::make_pair(node->d_target, node->d_slot)];
+			if(slot)
+			{
+				slot->d_command = std::move(node->d_command);
+				delete node;
+				++m_coalesced;
+				continue;
+			}
+
+			slot = node;
+			m_pending.push_back(node);
+		}
+	}
+
+	size_t UiQueue::drain()
+	{
+		TOY_ASSERT_UI_THREAD();
+		this->collect();
+
+		auto start = std::chrono::steady_clock::now();
+		size_t ran = 0;
+
+		while(!m_pending.empty())
+		{
+			// at least one command runs each frame, however long it takes
+			if(ran > 0 && m_budget > 0.f && Milliseconds(std::chrono::steady_clock::now() - start).count() > m_budget)
+				break;
+
+			// popped before it runs : the command can unbind widgets, which drops their own commands
+			unique_ptr<Node> node(m_pending.front());
+			m_pending.pop_front();
+			if(node->d_target)
+				m_slots.erase(std::make_pair(node->d_target, node->d_slot));
+
+			node->d_command();
+			++ran;
+		}
+
+		return ran;
+	}
+
+	bool UiQueue::alive(Node& node)
+	{
+		auto it = m_generations.find(node.d_target);
+		return it != m_generations.end() && (*it).second == node.d_generation;
+	}
+
+	void UiQueue::drop(Widget& target)
+	{
+		this->collect();
+		m_generations.erase(&target);
+		if(m_pending.empty())
+			return;
+
+		auto last = std::remove_if(m_pending.begin(), m_pending.end(), [&](Node* node) {
+			if(node->d_target != &target)
+				return false;
+			m_slots.erase(std::make_pair(node->d_target, node->d_slot));
+			delete node;
+			return true;
+		});
+		m_pending.erase(last, m_pending.end());
+	}
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2016 Hugo Amiard hugo.amiard@laposte.net
+//  This software is provided 'as-is' under the zlib License, see the LICENSE.txt file.
+//  This notice and the license may not be removed or altered from any source distribution.
+
+#ifndef TOY_UIQUEUE_H
+#define TOY_UIQUEUE_H
+
+/* toy */
+#include <toyobj/Util/NonCopy.h>
+#include <toyui/Forward.h>
+
+/* std */
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <cassert>
+
+namespace toy
+{
+	enum UiUpdateSlot : size_t
+	{
+		UPDATE_LABEL = 0,
+		UPDATE_VISIBLE = 1,
+		UPDATE_IMAGE = 2,
+		// custom updates use their own slots from here
+		UPDATE_USER = 16
+	};
+
+	/* A widget as named by the threads posting to it : taken on the ui thread, it goes stale when the widget leaves the tree
+	 * Commands posted to a stale target are discarded, even if another widget was allocated at the same address since
+	 */
+	struct UiTarget
+	{
+		Widget* d_widget;
+		size_t d_generation;
+	};
+
+	/* Commands posted to the ui from any thread, run on the ui thread at the start of a frame, before the relayout
+	 * Producers push onto a lock-free list, the ui thread takes the whole list at once and runs it in posting order
+	 * An update posted to a slot of a widget replaces the one still pending in the same slot, only the latest runs
+	 * The pending commands of a widget are dropped when it leaves the tree, and the later ones are discarded through the stale target
+	 */
+	class TOY_UI_EXPORT UiQueue : public NonCopy
+	{
+	public:
+		typedef std::function<void()> Command;
+
+	public:
+		UiQueue();
+		~UiQueue();
+
+		// called on the ui thread, the target is then handed to the posting threads
+		UiTarget target(Widget& widget);
+
+		// can be called from any thread
+		void post(const Command& command);
+		void post(const UiTarget& target, size_t slot, const Command& command);
+
+		void postLabel(const UiTarget& target, const string& label);
+		void postVisible(const UiTarget& target, bool visible);
+
+		// called on a post from another thread, to wake the ui thread if it waits for events
+		void setNotify(const Command& notify) { m_notify = notify; }
+
+		// milliseconds a frame spends running commands before leaving the rest for the next frame, zero runs them all
+		float budget() const { return m_budget; }
+		void setBudget(float ms) { m_budget = ms; }
+
+		// runs the pending commands within the budget, returns how many ran
+		size_t drain();
+		void drop(Widget& target);
+
+		size_t pending() { return m_pending.size(); }
+		size_t coalesced() { return m_coalesced; }
+
+		// the thread the widgets live on, set by the first window
+		static void setUiThread();
+		static bool onUiThread();
+
+	protected:
+		struct Node
+		{
+			Node* d_next;
+			Widget* d_target;
+			size_t d_generation;
+			size_t d_slot;
+			Command d_command;
+		};
+
+		void push(Node* node);
+		void collect();
+		bool alive(Node& node);
+
+	protected:
+		std::atomic<Node*> m_head;
+		Command m_notify;
+		float m_budget;
+
+		// only touched by the ui thread
+		std::deque<Node*> m_pending;
+		std::map<std::pair<Widget*, size_t>, Node*> m_slots;
+		std::unordered_map<Widget*, size_t> m_generations;
+		size_t m_lastGeneration;
+		size_t m_coalesced;
+
+		static std::thread::id s_uiThread;
+	};
+}
+
+#ifdef NDEBUG
+#define TOY_ASSERT_UI_THREAD()
+#else
+#define TOY_ASSERT_UI_THREAD() assert(toy::UiQueue::onUiThread() && "widgets are modified on the ui thread only, post to the UiQueue of the RootSheet instead")
+#endif
+
+#endif // TOY_UIQUEUE_H
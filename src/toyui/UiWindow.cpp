@@ -16,16 +16,28 @@
 
 #include <toyui/Frame/Frame.h>
 #include <toyui/Frame/Stripe.h>
+#include <toyui/Frame/Layer.h>
 
 #include <toyui/Controller/Controller.h>
 
 #include <stb_image.h>
 #include <dirent.h>
+#include <algorithm>
 
 namespace toy
 {
 	RenderSystem::RenderSystem(const string& resourcePath)
 		: m_resourcePath(resourcePath)
+		, m_images()
+		, m_atlas(1024, 1024)
+		, m_styler(make_unique<Styler>())
+		, m_sdfText(false)
+		, m_resourcesReady(false)
+		, m_resourceRenderer(nullptr)
+		, m_renderers()
+	{}
+
+	RenderSystem::~RenderSystem()
 	{}
 
 	Context::Context(RenderSystem& renderSystem, unique_ptr<RenderWindow> renderWindow, unique_ptr<InputWindow> inputWindow)
@@ -72,21 +84,103 @@ namespace toy
 		closedir(dir);
 	}
 
+	void RenderSystem::initResources()
+	{
+		if(m_resourcesReady)
+			return;
+
+		string spritePath = m_resourcePath + "interface/uisprites/";
+
+		DIR* dir = opendir(spritePath.c_str());
+		dirent* ent;
+
+		spritesInFolder(m_images, spritePath, "");
+
+		while((ent = readdir(dir)) != NULL)
+			if(ent->d_type & DT_DIR && string(ent->d_name) != "." && string(ent->d_name) != "..")
+				spritesInFolder(m_images, spritePath + ent->d_name + "/", string(ent->d_name) + "/");
+
+		closedir(dir);
+
+		m_atlas.generateAtlas(m_images);
+
+		string fontPath = m_resourcePath + "interface/fonts/DejaVuSans.ttf";
+		FILE* file = fopen(fontPath.c_str(), "rb");
+		if(file)
+		{
+			fseek(file, 0, SEEK_END);
+			m_fontData.resize(size_t(ftell(file)));
+			fseek(file, 0, SEEK_SET);
+			if(fread(m_fontData.data(), 1, m_fontData.size(), file) != m_fontData.size())
+				m_fontData.clear();
+			fclose(file);
+		}
+
+		// only the "dejavu" face is ever loaded in the renderers, its metrics are enough to lay out every caption
+		if(!m_fontData.empty())
+			m_fontMetrics.load(m_fontData.data(), m_fontData.size());
+		DrawFrame::sFontMetrics = &m_fontMetrics;
+
+		m_styler->defaultLayout();
+
+		m_resourcesReady = true;
+	}
+
+	void RenderSystem::loadResources(Renderer& renderer)
+	{
+		this->initResources();
+		m_renderers.push_back(&renderer);
+
+		if(m_resourceRenderer && renderer.shareResources(*m_resourceRenderer, *this))
+			return;
+
+		renderer.loadFont();
+
+		for(Image& image : m_images)
+			renderer.loadImage(image);
+
+		renderer.loadImageRGBA(m_atlas.image(), m_atlas.data());
+
+		if(!m_resourceRenderer)
+			m_resourceRenderer = &renderer;
+	}
+
+	void RenderSystem::unloadResources(Renderer& renderer)
+	{
+		m_renderers.erase(std::find(m_renderers.begin(), m_renderers.end(), &renderer));
+
+		// the window that loaded the textures closes first : a window sharing them takes them over instead of losing them
+		if(&renderer == m_resourceRenderer)
+			for(Renderer* other : m_renderers)
+				if(other->adoptResources(renderer))
+				{
+					m_resourceRenderer = other;
+					return;
+				}
+
+		for(Image& image : m_images)
+			renderer.unloadImage(image);
+		renderer.unloadImage(m_atlas.image());
+
+		if(&renderer == m_resourceRenderer)
+			m_resourceRenderer = nullptr;
+	}
+
 	UiWindow::UiWindow(RenderSystem& system, const string& name, int width, int height, bool fullScreen, User* user)
 		: m_system(system)
 		, m_resourcePath(system.resourcePath())
 		, m_context(system.createContext(name, width, height, fullScreen))
 		, m_renderer(system.createRenderer(*m_context))
 		, m_images()
-		, m_atlas(1024, 1024)
 		, m_width(m_context->renderWindow().width())
 		, m_height(m_context->renderWindow().height())
-		, m_styler(make_unique<Styler>())
 		, m_rootSheet(nullptr)
 		, m_shutdownRequested(false)
+		, m_replay(false)
+		, m_replayTick(0)
+		, m_replayDelta(0)
 		, m_user(user)
 	{
-		this->initResources();
 		this->init();
 	}
 
@@ -95,6 +189,8 @@ namespace toy
 		for(Image& image : m_images)
 			m_renderer->unloadImage(image);
 
+		m_system.unloadResources(*m_renderer);
+
 		m_rootSheet->clear();
 	}
 
@@ -103,11 +199,12 @@ namespace toy
 		printf("UiWindow Init\n");
 		m_renderer->setupContext();
 
-		this->loadResources();
+		m_system.loadResources(*m_renderer);
 
-		m_styler->defaultLayout();
+		UiQueue::setUiThread();
 
 		m_rootSheet = make_unique<RootSheet>(*this);
+		m_rootSheet->queue().setNotify([this] { m_context->inputWindow().wakeEvents(); });
 		//m_rootDevice = make_unique<RootDevice>(*this, *m_rootSheet);
 
 		m_context->inputWindow().initInput(m_rootSheet->mouse(), m_rootSheet->keyboard());
@@ -119,34 +216,6 @@ namespace toy
 		printf("UiWindow Init End\n");
 	}
 
-	void UiWindow::initResources()
-	{
-		string spritePath = m_resourcePath + "interface/uisprites/";
-
-		DIR* dir = opendir(spritePath.c_str());
-		dirent* ent;
-
-		spritesInFolder(m_images, spritePath, "");
-
-		while((ent = readdir(dir)) != NULL)
-			if(ent->d_type & DT_DIR && string(ent->d_name) != "." && string(ent->d_name) != "..")
-				spritesInFolder(m_images, spritePath + ent->d_name + "/", string(ent->d_name) + "/");
-
-		closedir(dir);
-	}
-
-	void UiWindow::loadResources()
-	{
-		m_renderer->loadFont();
-
-		m_atlas.generateAtlas(m_images);
-
-		for(Image& image : m_images)
-			m_renderer->loadImage(image);
-
-		m_renderer->loadImageRGBA(m_atlas.image(), m_atlas.data());
-	}
-
 	Image& UiWindow::createImage(const string& name, int width, int height, uint8_t* data)
 	{
 		m_images.emplace_back(name, name, width, height);
@@ -167,21 +236,53 @@ namespace toy
 
 	bool UiWindow::nextFrame()
 	{
+		m_context->renderWindow().makeCurrent();
+
+		if(m_scheduler.vsyncChanged())
+			m_context->renderWindow().setVsync(m_scheduler.vsync());
+
+		m_scheduler.beginFrame();
+
+		// input and updates come first, so that the frame shows their effect without waiting for the next one
+		if(!m_replay)
+			m_context->inputWindow().nextFrame();
+
 		if(m_context->renderWindow().width() != size_t(m_width)
 		|| m_context->renderWindow().height() != size_t(m_height))
 			this->resize(m_context->renderWindow().width(), m_context->renderWindow().height());
 
+		size_t tick = m_replay ? m_replayTick : m_clock.readTick();
+		size_t delta = m_replay ? m_replayDelta : m_clock.stepTick();
+
+		// running animations keep the full rate until they end
+		m_animator.update(tick);
+		if(m_animator.active())
+			m_scheduler.wake();
+
+		m_rootSheet->nextFrame(tick, delta);
+
+#ifdef TOYUI_DRAW_CACHE
+		// the damage is consumed by the render, it has to be read before
+		MasterLayer& masterLayer = m_rootSheet->target().layer();
+		bool damaged = masterLayer.fullDamage() || !masterLayer.damage().empty();
+#endif
+
 		// if(manualRender)
 		m_rootSheet->target().render();
 		// add sub layers
 
-		m_context->renderWindow().nextFrame();
-		m_context->inputWindow().nextFrame();
+#ifdef TOYUI_DRAW_CACHE
+		// a layer was recorded again or a rect changed on screen : an animation or a deferred update is running, keep the full rate
+		if(damaged || m_renderer->drawnFrames() > 0)
+			m_scheduler.wake();
+#endif
 
-		size_t tick = m_clock.readTick();
-		size_t delta = m_clock.stepTick();
+		m_scheduler.presentFrame();
+		m_context->renderWindow().nextFrame();
 
-		m_rootSheet->nextFrame(tick, delta);
+		double wait = m_scheduler.endFrame();
+		if(wait > 0.0 && !m_replay)
+			m_context->inputWindow().waitEvents(wait);
 
 		return !m_shutdownRequested;
 	}
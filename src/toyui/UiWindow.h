@@ -12,23 +12,60 @@
 //#include <toyui/Device/RootDevice.h>
 #include <toyui/Render/RenderWindow.h>
 #include <toyui/ImageAtlas.h>
+#include <toyui/FrameScheduler.h>
+#include <toyui/Animator.h>
+#include <toyui/Render/FontMetrics.h>
 
 #include <vector>
 
 namespace toy
 {
+	/* Resources shared by all the windows created from a render system : sprites and their atlas, font data and styles
+	 * The first renderer to load them owns their textures, the renderers of later windows share them when they can
+ * The font metrics are read from the font data, all the captions are measured with them whatever renders them
+	 */
 	class TOY_UI_EXPORT RenderSystem
 	{
 	public:
 		RenderSystem(const string& resourcePath);
+		virtual ~RenderSystem();
 
 		const string& resourcePath() const { return m_resourcePath; }
 
+		std::vector<Image>& images() { return m_images; }
+		ImageAtlas& imageAtlas() { return m_atlas; }
+		const std::vector<unsigned char>& fontData() const { return m_fontData; }
+		const FontMetrics& fontMetrics() const { return m_fontMetrics; }
+
+		Styler& styler() { return *m_styler; }
+
+		// renderers created afterwards draw text with a distance field font when they support it
+		void setSdfText(bool enabled) { m_sdfText = enabled; }
+		bool sdfText() const { return m_sdfText; }
+
 		virtual unique_ptr<Context> createContext(const string& name, int width, int height, bool fullScreen) = 0;
 		virtual unique_ptr<Renderer> createRenderer(Context& context) = 0;
 
+		void loadResources(Renderer& renderer);
+		void unloadResources(Renderer& renderer);
+
+	protected:
+		void initResources();
+
 	protected:
 		string m_resourcePath;
+
+		std::vector<Image> m_images;
+		ImageAtlas m_atlas;
+		std::vector<unsigned char> m_fontData;
+		FontMetrics m_fontMetrics;
+
+		unique_ptr<Styler> m_styler;
+
+		bool m_sdfText;
+		bool m_resourcesReady;
+		Renderer* m_resourceRenderer;
+		std::vector<Renderer*> m_renderers;
 	};
 
 	class TOY_UI_EXPORT Context
@@ -66,7 +103,7 @@ namespace toy
 		Renderer& renderer() const { return *m_renderer; }
 
 		std::vector<Image>& images() { return m_images; }
-		ImageAtlas& imageAtlas() { return m_atlas; }
+		ImageAtlas& imageAtlas() { return m_system.imageAtlas(); }
 
 		const string& resourcePath() const { return m_resourcePath; }
 
@@ -76,7 +113,10 @@ namespace toy
 		RootSheet& rootSheet() const { return *m_rootSheet; }
 		RootDevice& rootDevice() const { return *m_rootDevice; }
 
-		Styler& styler() const { return *m_styler; }
+		Styler& styler() const { return m_system.styler(); }
+
+		FrameScheduler& scheduler() { return m_scheduler; }
+		Animator& animator() { return m_animator; }
 
 		bool shutdownRequested() const { return m_shutdownRequested; }
 		
@@ -88,16 +128,17 @@ namespace toy
 
 		bool nextFrame();
 
+		// replay : the frames are clocked by the recorded ticks and the live input is neither polled nor waited on
+		void beginReplay() { m_replay = true; m_replayTick = 0; m_replayDelta = 0; }
+		void endReplay() { m_replay = false; }
+		void setReplayTick(size_t tick) { m_replayDelta = tick - m_replayTick; m_replayTick = tick; }
+
 		void shutdown();
 
 		void handleResizeWindow(size_t width, size_t height);
 
 		Image& createImage(const string& image, int width, int height, uint8_t* data);
 
-	protected:
-		void initResources();
-		void loadResources();
-
 	protected:
 		RenderSystem& m_system;
 		string m_resourcePath;
@@ -105,13 +146,15 @@ namespace toy
 		unique_ptr<Context> m_context;
 		unique_ptr<Renderer> m_renderer;
 
+		// images created by this window only, the sprites belong to the render system
 		std::vector<Image> m_images;
-		ImageAtlas m_atlas;
 
 		float m_width;
 		float m_height;
 
-		unique_ptr<Styler> m_styler;
+		// declared before the root sheet, which cancels its scheduled callbacks and stops its tweens when destroyed
+		FrameScheduler m_scheduler;
+		Animator m_animator;
 
 		//unique_ptr<RootDevice> m_rootDevice;
 		unique_ptr<RootSheet> m_rootSheet;
@@ -122,6 +165,10 @@ namespace toy
 
 		Clock m_clock;
 
+		bool m_replay;
+		size_t m_replayTick;
+		size_t m_replayDelta;
+
 		User* m_user;
 	};
 }
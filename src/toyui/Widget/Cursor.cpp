@@ -11,6 +11,8 @@
 
 #include <toyui/Widget/RootSheet.h>
 
+#include <toyui/UiWindow.h>
+
 #include <toyobj/Iterable/Reverse.h>
 
 namespace toy
@@ -18,18 +20,17 @@ namespace toy
 	Cursor::Cursor(RootSheet& rootSheet)
 		: Decal(rootSheet, cls())
 		, m_tooltip(rootSheet, "")
+		, m_scheduler(rootSheet.uiWindow().scheduler())
+		, m_tooltipDelay(0)
 	{
 		m_hovered = &rootSheet;
 
 		this->tooltipOff();
 	}
 
-	void Cursor::nextFrame(size_t tick, size_t delta)
+	Cursor::~Cursor()
 	{
-		Wedge::nextFrame(tick, delta);
-
-		if(m_tooltipClock.read() > 0.5f && m_tooltip.frame().hidden() && !m_hovered->tooltip().empty())
-			this->tooltipOn();
+		m_scheduler.cancel(m_tooltipDelay);
 	}
 
 	void Cursor::setPosition(float x, float y)
@@ -39,7 +40,14 @@ namespace toy
 
 		if(!m_tooltip.frame().hidden())
 			this->tooltipOff();
-		m_tooltipClock.step();
+
+		// the tooltip shows once the cursor rested for half a second
+		m_scheduler.cancel(m_tooltipDelay);
+		m_tooltipDelay = m_scheduler.schedule(0.5f, [this] {
+			if(m_tooltip.frame().hidden() && !m_hovered->tooltip().empty())
+				this->tooltipOn();
+		});
+
 		m_frame->setPosition(x, y);
 	}
 
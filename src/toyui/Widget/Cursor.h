@@ -6,9 +6,9 @@
 #define TOY_CURSOR_H
 
 /* toy */
-#include <toyobj/Util/Timer.h>
 #include <toyui/Forward.h>
 #include <toyui/Widget/Sheet.h>
+#include <toyui/FrameScheduler.h>
 
 namespace toy
 {
@@ -26,8 +26,7 @@ namespace toy
 	{
 	public:
 		Cursor(RootSheet& rootSheet);
-
-		void nextFrame(size_t tick, size_t delta);
+		~Cursor();
 
 		void setPosition(float x, float y);
 
@@ -44,7 +43,8 @@ namespace toy
 		bool m_dirty;
 		Widget* m_hovered;
 		Tooltip m_tooltip;
-		Clock m_tooltipClock;
+		FrameScheduler& m_scheduler;
+		FrameScheduler::CallbackId m_tooltipDelay;
 	};
 
 	class TOY_UI_EXPORT ResizeCursorX : public Object
@@ -15,6 +15,8 @@
 
 #include <toyui/Input/InputDevice.h>
 
+#include <toyui/Edit/Value.h>
+
 #include <toyui/UiWindow.h>
 #include <toyui/UiLayout.h>
 
@@ -27,9 +29,13 @@ namespace toy
 	RootSheet::RootSheet(UiWindow& window, Type& type)
 		: Container(type, MASTER_LAYER)
 		, m_window(window)
+		, m_arena()
+		, m_queue()
 		, m_mouse(make_unique<Mouse>(*this))
 		, m_keyboard(make_unique<Keyboard>(*this))
+		, m_valueRefresh(make_unique<ValueRefresh>())
 		, m_cursor(*this)
+		, m_frameIndex(0)
 	{
 		m_target = window.renderer().createRenderTarget(m_frame->as<MasterLayer>());
 		this->updateStyle();
@@ -38,22 +44,37 @@ namespace toy
 	RootSheet::RootSheet(Wedge& parent, Type& type)
 		: Container(parent, type, LAYER)
 		, m_window(parent.uiWindow())
+		, m_arena()
+		, m_queue()
 		, m_mouse(make_unique<Mouse>(*this))
 		, m_keyboard(make_unique<Keyboard>(*this))
+		, m_valueRefresh(make_unique<ValueRefresh>())
 		, m_cursor(*this)
+		, m_frameIndex(0)
 	{}
 
 	RootSheet::~RootSheet()
-	{}
+	{
+		// the contents must go before the arena they were allocated in
+		this->clear();
+	}
 
 	void RootSheet::nextFrame(size_t tick, size_t delta)
 	{
+		// commands posted by other threads land before the values refresh and the relayout
+		if(m_queue.drain() > 0 || m_queue.pending() > 0)
+			m_window.scheduler().wake();
+
+		m_valueRefresh->flush();
+
 		m_frame->as<MasterLayer>().relayout();
 
 		m_mouse->nextFrame();
 		m_keyboard->nextFrame();
 
 		Wedge::nextFrame(tick, delta);
+
+		++m_frameIndex;
 	}
 
 	InputReceiver* RootSheet::dispatchEvent(InputEvent& inputEvent)
@@ -65,6 +86,8 @@ namespace toy
 	{
 		m_cursor.unhover(widget);
 		m_mouse->handleUnbindWidget(widget);
+		m_queue.drop(widget);
+		m_window.animator().stop(widget.frame());
 	}
 
 	void RootSheet::handleBindWidget(Widget& widget)
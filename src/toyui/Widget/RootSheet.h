@@ -11,6 +11,8 @@
 #include <toyui/Widget/Sheet.h>
 #include <toyui/Widget/Cursor.h>
 #include <toyui/Input/InputDispatcher.h>
+#include <toyui/UiArena.h>
+#include <toyui/UiQueue.h>
 
 namespace toy
 {
@@ -26,13 +28,19 @@ namespace toy
 		virtual InputFrame& rootController() { return *this; }
 
 		UiWindow& uiWindow() { return m_window; }
+		UiArena& arena() { return m_arena; }
+		// other threads keep a reference to the queue taken on the ui thread, and post their updates there
+		UiQueue& queue() { return m_queue; }
 		Mouse& mouse() const { return *m_mouse; }
 		Keyboard& keyboard() const { return *m_keyboard; }
+		ValueRefresh& valueRefresh() { return *m_valueRefresh; }
 
 		Cursor& cursor() { return m_cursor; }
 
 		RenderTarget& target() { return *m_target; }
 
+		size_t frameIndex() { return m_frameIndex; }
+
 		void nextFrame(size_t tick, size_t delta);
 
 		virtual void transformCoordinates(MouseEvent& mouseEvent) { UNUSED(mouseEvent); }
@@ -45,13 +53,18 @@ namespace toy
 
 	protected:
 		UiWindow& m_window;
+		UiArena m_arena;
+		UiQueue m_queue;
 
 		unique_ptr<Mouse> m_mouse;
 		unique_ptr<Keyboard> m_keyboard;
+		unique_ptr<ValueRefresh> m_valueRefresh;
 
 		unique_ptr<RenderTarget> m_target;
 
 		Cursor m_cursor;
+
+		size_t m_frameIndex;
 	};
 }
 
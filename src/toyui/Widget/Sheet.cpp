@@ -19,6 +19,9 @@
 
 #include <toyobj/Iterable/Reverse.h>
 
+/* std */
+#include <algorithm>
+
 namespace toy
 {
 	Wedge::Wedge(Wedge& parent, Type& type, FrameType frameType)
@@ -48,13 +51,62 @@ namespace toy
 		m_frame->content().beginDraw(renderer, force);
 		m_frame->content().draw(renderer, force);
 
+		BoxFloat parentViewport = renderer.viewport();
+		bool parentBounded = renderer.bounded();
+
+		BoxFloat viewport;
+		bool bounded = this->localViewport(parentViewport, parentBounded, viewport);
+		renderer.setViewport(viewport, bounded);
+
 		for(size_t i = 0; i < m_contents.size(); ++i)
-			if(!m_contents[i]->frame().hidden())
-				m_contents[i]->render(renderer, force);
+		{
+			Frame& frame = m_contents[i]->frame();
+			if(frame.hidden())
+				continue;
+
+			// a child outside the visible rect is skipped with its whole subtree, layers float and are never culled
+			if(bounded && frame.frameType() < LAYER)
+			{
+				BoxFloat bounds(frame.dposition(DIM_X), frame.dposition(DIM_Y), frame.width() * frame.scale(), frame.height() * frame.scale());
+				if(!viewport.intersects(bounds))
+				{
+					// counted against the frames repainted : a child of a cached layer would not be painted anyway
+					if(m_frame->layer().redraw() || force)
+						renderer.countCulled();
+					continue;
+				}
+			}
 
+			m_contents[i]->render(renderer, force);
+		}
+
+		renderer.setViewport(parentViewport, parentBounded);
 		m_frame->content().endDraw(renderer);
 	}
 
+	bool Wedge::localViewport(const BoxFloat& parentViewport, bool parentBounded, BoxFloat& viewport)
+	{
+		bool bounded = parentBounded && m_frame->frameType() < LAYER;
+		if(bounded)
+		{
+			float x = (parentViewport.x() - m_frame->dposition(DIM_X)) / m_frame->scale();
+			float y = (parentViewport.y() - m_frame->dposition(DIM_Y)) / m_frame->scale();
+			viewport = BoxFloat(x, y, parentViewport.w() / m_frame->scale(), parentViewport.h() / m_frame->scale());
+		}
+
+		if(m_frame->clip())
+		{
+			float x0 = bounded ? std::max(viewport.x(), 0.f) : 0.f;
+			float y0 = bounded ? std::max(viewport.y(), 0.f) : 0.f;
+			float x1 = bounded ? std::min(viewport.x() + viewport.w(), m_frame->width()) : m_frame->width();
+			float y1 = bounded ? std::min(viewport.y() + viewport.h(), m_frame->height()) : m_frame->height();
+			viewport = BoxFloat(x0, y0, std::max(x1 - x0, 0.f), std::max(y1 - y0, 0.f));
+			bounded = true;
+		}
+
+		return bounded;
+	}
+
 	void Wedge::visit(const Visitor& visitor)
 	{
 		bool pursue = visitor(*this);
@@ -92,6 +144,16 @@ namespace toy
 		this->reindex(index);
 	}
 
+	void Wedge::prune()
+	{
+		// drop the widgets unbound from this wedge in one pass, the remaining ones are mapped again on the next relayout
+		auto end = std::remove_if(m_contents.begin(), m_contents.end(), [this](Widget* widget) { return widget->parent() != this; });
+		m_contents.erase(end, m_contents.end());
+		this->reindex(0);
+
+		m_frame->markDirty(Frame::DIRTY_MAPPING);
+	}
+
 	void Wedge::move(size_t from, size_t to)
 	{
 		m_contents.insert(m_contents.begin() + to, m_contents[from]);
@@ -125,6 +187,7 @@ namespace toy
 
 	Widget& Container::insert(unique_ptr<Widget> unique, size_t index)
 	{
+		TOY_ASSERT_UI_THREAD();
 		Widget& widget = *unique;
 		if(widget.parent() == nullptr)
 			this->emplaceContainer().as<Wedge>().insert(widget, index, false);
@@ -136,6 +199,7 @@ namespace toy
 
 	unique_ptr<Widget> Container::release(Widget& widget)
 	{
+		TOY_ASSERT_UI_THREAD();
 		widget.parent()->remove(widget);
 		auto pos = std::find_if(m_containerContents.begin(), m_containerContents.end(), [&widget](auto& pt) { return pt.get() == &widget; });
 		unique_ptr<Widget> pointer = std::move(*pos);
@@ -146,12 +210,33 @@ namespace toy
 
 	void Container::clear()
 	{
+		TOY_ASSERT_UI_THREAD();
+		if(m_containerContents.empty())
+			return;
+
+		std::vector<Wedge*> parents;
+		for(auto& widget : m_containerContents)
+			if(std::find(parents.begin(), parents.end(), widget->parent()) == parents.end())
+				parents.push_back(widget->parent());
+
+		// the parent frames are emptied at once, so that none of them is left pointing to a destroyed frame until it is remapped
+		for(Wedge* parent : parents)
+			parent->stripe().unmap();
+
 		for(auto& widget : m_containerContents)
-			widget->parent()->remove(*widget);
+			widget->unbind(false);
+
+		for(Wedge* parent : parents)
+			parent->prune();
 
 		m_containerContents.clear();
 	}
 
+	UiArena& Container::arena()
+	{
+		return this->rootSheet().arena();
+	}
+
 	WrapControl::WrapControl(Wedge& parent, Type& type)
 		: Container(parent, type)
 	{}
@@ -29,6 +29,8 @@ namespace toy
 		virtual void nextFrame(size_t tick, size_t delta);
 		virtual void render(Renderer& renderer, bool force);
 
+		bool localViewport(const BoxFloat& parentViewport, bool parentBounded, BoxFloat& viewport);
+
 		virtual void visit(const Visitor& visitor);
 
 		void push(Widget& widget, bool deferred = true);
@@ -36,6 +38,7 @@ namespace toy
 		void remove(Widget& widget);
 
 		void reindex(size_t from);
+		void prune();
 		void move(size_t from, size_t to);
 		void swap(size_t from, size_t to);
 
@@ -67,17 +70,19 @@ namespace toy
 
 		void clear();
 
+		UiArena& arena();
+
 		template <class T, class... Args>
 		inline T& emplace(Args&&... args)
 		{
 			Container& container = this->emplaceContainer();
-			return this->append(make_unique<T>(container.as<Wedge>(), std::forward<Args>(args)...)).template as<T>();
+			return this->append(unique_ptr<T>(new (&this->arena()) T(container.as<Wedge>(), std::forward<Args>(args)...))).template as<T>();
 		}
 
 		template <class T, class... Args>
 		inline T& emplaceLocal(Wedge& container, Args&&... args)
 		{
-			return this->append(make_unique<T>(container, std::forward<Args>(args)...)).template as<T>();
+			return this->append(unique_ptr<T>(new (&this->arena()) T(container, std::forward<Args>(args)...))).template as<T>();
 		}
 
 		static Type& cls() { static Type ty("Container", Wedge::cls()); return ty; }
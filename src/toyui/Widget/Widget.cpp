@@ -37,20 +37,22 @@ namespace toy
 		, m_state(NOSTATE)
 		, m_device(nullptr)
 	{
+		UiArena* arena = m_parent ? &m_parent->rootSheet().arena() : nullptr;
+
 		if(frameType == MASTER_LAYER)
-			m_frame = make_unique<MasterLayer>(*this);
+			m_frame.reset(new (arena) MasterLayer(*this));
 		else if(frameType == LAYER)
-			m_frame = make_unique<Layer>(*this);
+			m_frame.reset(new (arena) Layer(*this));
 		else if(frameType == GRID)
-			m_frame = make_unique<Grid>(*this);
+			m_frame.reset(new (arena) Grid(*this));
 		else if(frameType == TABLE)
-			m_frame = make_unique<TableGrid>(*this);
+			m_frame.reset(new (arena) TableGrid(*this));
 		else if(frameType == MULTIGRID)
-			m_frame = make_unique<MultiGrid>(*this);
+			m_frame.reset(new (arena) MultiGrid(*this));
 		else if(frameType == STRIPE)
-			m_frame = make_unique<Stripe>(*this);
+			m_frame.reset(new (arena) Stripe(*this));
 		else if(frameType == FRAME)
-			m_frame = make_unique<Frame>(*this);
+			m_frame.reset(new (arena) Frame(*this));
 
 		if(m_parent)
 			this->updateStyle();
@@ -86,9 +88,16 @@ namespace toy
 
 	void Widget::setLabel(const string& label)
 	{
+		TOY_ASSERT_UI_THREAD();
 		this->content().setText(label);
 	}
 
+	void Widget::setLabelRef(const string& label, const size_t* stamp)
+	{
+		TOY_ASSERT_UI_THREAD();
+		this->content().setTextRef(label, stamp);
+	}
+
 	Image* Widget::image()
 	{
 		return this->content().image();
@@ -107,7 +116,7 @@ namespace toy
 	void Widget::bind(Wedge& parent, size_t index, bool deferred)
 	{
 		m_parent = &parent;
-		m_parentFrame = &parent;
+		this->setParentFrame(&parent);
 		m_index = index;
 		
 		if(deferred)
@@ -119,15 +128,18 @@ namespace toy
 		this->visit([&rootSheet](Widget& widget) { rootSheet.handleBindWidget(widget); return true; });
 	}
 
-	void Widget::unbind()
+	void Widget::unbind(bool unmap)
 	{
 		RootSheet& rootSheet = this->rootSheet();
 		this->visit([&rootSheet](Widget& widget) { rootSheet.handleUnbindWidget(widget); return true; });
 
-		m_parent->stripe().unmap(*m_frame);
+		if(unmap)
+			m_parent->stripe().unmap(*m_frame);
+		else
+			m_parent->stripe().unmapped(*m_frame);
 
 		m_parent = nullptr;
-		m_parentFrame = nullptr;
+		this->setParentFrame(nullptr);
 		m_index = 0;
 	}
 
@@ -169,9 +181,20 @@ namespace toy
 
 	void Widget::nextFrame(size_t tick, size_t step)
 	{
-		if(m_frame->dirty())
+#ifdef TOYUI_DRAW_CACHE
+		// moving an offscreen layer only changes where its target is composited
+		bool moved = m_frame->dirty() == Frame::DIRTY_ABSOLUTE && m_frame->frameType() == LAYER && m_frame->as<Layer>().offscreen();
+#else
+		bool moved = false;
+#endif
+		m_frame->content().updateTextRef();
+
+		if(m_frame->dirty() && !moved)
 			m_frame->layer().setRedraw();
 
+		if(m_frame->damaged())
+			m_frame->updateDamage();
+
 		m_frame->clearDirty();
 
 		if(m_style->updated() > m_frame->styleStamp())
@@ -187,11 +210,13 @@ namespace toy
 
 	void Widget::show()
 	{
+		TOY_ASSERT_UI_THREAD();
 		m_frame->show();
 	}
 	
 	void Widget::hide()
 	{
+		TOY_ASSERT_UI_THREAD();
 		m_frame->hide();
 	}
 
@@ -224,6 +249,7 @@ namespace toy
 
 	void Widget::toggleState(WidgetState state)
 	{
+		TOY_ASSERT_UI_THREAD();
 		m_state = static_cast<WidgetState>(m_state ^ state);
 		this->updateState();
 	}
@@ -242,8 +268,8 @@ namespace toy
 
 	void Widget::updateState()
 	{
+		// the inkstyle update marks the frame : a paint only transition never triggers a relayout
 		m_frame->content().updateInkstyle(m_style->subskin(m_state));
-		m_frame->setDirty(Frame::DIRTY_CONTENT);
 	}
 
 	Widget* Widget::pinpoint(float x, float y)
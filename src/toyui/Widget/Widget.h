@@ -13,6 +13,7 @@
 #include <toyui/Frame/Uibox.h>
 #include <toyui/Input/InputDispatcher.h>
 #include <toyui/Style/Style.h>
+#include <toyui/UiArena.h>
 
 #include <functional>
 #include <memory>
@@ -40,6 +41,8 @@ namespace toy
 		Widget(Type& type = cls(), FrameType frameType = FRAME, Wedge* parent = nullptr);
 		~Widget();
 
+		TOY_UI_ARENA_ALLOCATED
+
 		_A_ inline Wedge* parent() { return m_parent; }
 		_A_ inline Container* container() { return m_container; }
 		_A_ inline size_t index() { return m_index; }
@@ -56,6 +59,7 @@ namespace toy
 
 		const string& label();
 		void setLabel(const string& label);
+		void setLabelRef(const string& label, const size_t* stamp = nullptr);
 
 		Image* image();
 		void setImage(Image* image);
@@ -77,7 +81,7 @@ namespace toy
 		void hide();
 
 		void bind(Wedge& parent, size_t index, bool deferred = true);
-		void unbind();
+		void unbind(bool unmap = true);
 
 		unique_ptr<Widget> extract();
 
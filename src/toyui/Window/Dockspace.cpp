@@ -160,16 +160,12 @@ namespace toy
 			m_dockline->removeLine(*this);
 	}
 
-	Dockline& Dockline::findLine(const GridIndex& inputDockid)
+	Dockline& Dockline::findLine(const GridIndex& dockid)
 	{
-		GridIndex dockid = inputDockid;
-		std::reverse(dockid.begin(), dockid.end());
-
 		Dockline* dockline = this;
 
-		while(dockid.size() > 0)
+		for(size_t index : dockid)
 		{
-			size_t index = dockid.back(); dockid.pop_back();
 			if(index >= dockline->count())
 				dockline->appendLine();
 			dockline = &dockline->at(index).as<Dockline>();
@@ -171,6 +171,8 @@ namespace toy
 		mouseEvent.abort = true;
 	}
 
+	bool Window::sOffscreen = true;
+
 	Window::Window(Wedge& parent, const string& title, WindowState state, const Trigger& onClose, Docksection* dock, Type& type)
 		: Overlay(parent, type)
 		, m_name(title)
@@ -195,6 +197,7 @@ namespace toy
 			float x = (m_parent->frame().dsize(DIM_X) - m_frame->dsize(DIM_X)) / 2.f;
 			float y = (m_parent->frame().dsize(DIM_Y) - m_frame->dsize(DIM_Y)) / 2.f;
 			m_frame->setPosition(x, y);
+			m_frame->as<Layer>().setOffscreen(sOffscreen);
 		}
 	}
 
@@ -253,6 +256,7 @@ namespace toy
 		this->setStyle(DockWindow::cls());
 		this->toggleMovable();
 		this->toggleResizable();
+		m_frame->as<Layer>().setOffscreen(false);
 	}
 
 	void Window::undock()
@@ -271,6 +275,7 @@ namespace toy
 		DimFloat absolute = m_frame->absolutePosition();
 		m_frame->setPosition(absolute[DIM_X], absolute[DIM_Y]);
 		m_frame->as<Layer>().moveToTop();
+		m_frame->as<Layer>().setOffscreen(sOffscreen);
 	}
 	
 	void Window::close()
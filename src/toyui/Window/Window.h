@@ -167,6 +167,9 @@ namespace toy
 
 		static Type& cls() { static Type ty("Window", Overlay::cls()); return ty; }
 
+		// floating windows are rasterized offscreen : dragging one only composites its target again
+		static bool sOffscreen;
+
 	protected:
 		string m_name;
 		WindowState m_windowState;